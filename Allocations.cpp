@@ -0,0 +1,338 @@
+// Objective: Implement the Allocations class, the counting global operator new and operator delete, and the allocation report
+
+// Include the necessary header files
+#include "Allocations.hpp"
+#include "EuropeanOption.hpp"
+#include "PerpetualAmericanOption.hpp"
+#include "Matrix.hpp"
+#include "Greeks.hpp"
+#include "Kernels.hpp"
+#include "Serialization.hpp"
+#include "BumpGreeks.hpp"
+#include "SensitivityEngine.hpp"
+#include "Sweep.hpp"
+#include "OptionBook.hpp"
+#include "ScenarioEngine.hpp"
+#include "GridPricer.hpp"
+#include "TimeProjection.hpp"
+#include "ChebyshevProxy.hpp"
+#include "ShardedBook.hpp"
+#include <iostream>
+using namespace std;
+#include <vector>
+#include <string>
+#include <functional>
+#include <new>
+#include <cstdlib>
+#include <cstdio>
+#include <atomic>
+
+
+
+// The counters of the calling thread
+// They are plain integers with no constructor, so they can be used by an allocation made before or during the start of a thread
+static thread_local unsigned long long allocation_count = 0;
+static thread_local unsigned long long allocation_bytes = 0;
+
+// The counters of the process
+// std::atomic has a constexpr constructor, so they are initialized before any code runs, and relaxed increments are enough for counting
+static std::atomic<unsigned long long> total_count(0);
+static std::atomic<unsigned long long> total_bytes(0);
+
+
+
+#ifdef ALLOCATION_TRACKING
+
+// Allocates a block, counting it for the calling thread and the process
+static void* Allocate(std::size_t size, std::size_t alignment) {
+
+	++allocation_count;
+	allocation_bytes += size;
+
+	total_count.fetch_add(1, std::memory_order_relaxed);
+	total_bytes.fetch_add(size, std::memory_order_relaxed);
+
+	if (size == 0) size = 1;
+
+	void* block;
+
+	if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+		block = std::malloc(size);
+	}
+
+	else {
+#ifdef _WIN32
+		block = _aligned_malloc(size, alignment);
+#else
+		block = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+	}
+
+	if (block == 0) throw std::bad_alloc();
+
+	return block;
+}
+
+
+// Frees a block from Allocate
+static void Free(void* block, std::size_t alignment) {
+
+#ifdef _WIN32
+	if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+		_aligned_free(block);
+		return;
+	}
+#endif
+
+	std::free(block);
+}
+
+
+// The replacements of the global operators
+// The nothrow forms of the standard library call the plain forms, so they are counted as well
+
+void* operator new(std::size_t size) {
+	return Allocate(size, 0);
+}
+
+void* operator new[](std::size_t size) {
+	return Allocate(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	return Allocate(size, std::size_t(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+	return Allocate(size, std::size_t(alignment));
+}
+
+void operator delete(void* block) noexcept {
+	Free(block, 0);
+}
+
+void operator delete[](void* block) noexcept {
+	Free(block, 0);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+	Free(block, 0);
+}
+
+void operator delete[](void* block, std::size_t) noexcept {
+	Free(block, 0);
+}
+
+void operator delete(void* block, std::align_val_t alignment) noexcept {
+	Free(block, std::size_t(alignment));
+}
+
+void operator delete[](void* block, std::align_val_t alignment) noexcept {
+	Free(block, std::size_t(alignment));
+}
+
+void operator delete(void* block, std::size_t, std::align_val_t alignment) noexcept {
+	Free(block, std::size_t(alignment));
+}
+
+void operator delete[](void* block, std::size_t, std::align_val_t alignment) noexcept {
+	Free(block, std::size_t(alignment));
+}
+
+#endif
+
+
+
+// Returns true if the tracking operators are compiled in
+bool Allocations::Tracking() {
+#ifdef ALLOCATION_TRACKING
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+// Returns the number of heap allocations of the calling thread
+unsigned long long Allocations::Count() {
+	return allocation_count;
+}
+
+
+// Returns the bytes allocated by the calling thread
+unsigned long long Allocations::Bytes() {
+	return allocation_bytes;
+}
+
+
+// Returns the number of heap allocations of the process
+unsigned long long Allocations::TotalCount() {
+	return total_count.load(std::memory_order_relaxed);
+}
+
+
+// Returns the bytes allocated by the process
+unsigned long long Allocations::TotalBytes() {
+	return total_bytes.load(std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Results of the calls of the report are stored here so the compiler cannot drop the calls
+static volatile double sink = 0;
+
+
+// An API of the report: its name, whether it is certified allocation-free, and a call of it
+struct AllocationCase {
+	std::string name;
+	bool core;
+	std::function<void()> call;
+};
+
+
+
+// Measures and outputs the allocations per call of every API
+// The inputs of every call are built before the measurements, so only the calls themselves are counted
+// The engines are given several threads so that their Scheduler paths are measured even on a machine with one core
+// Returns -1 without measuring anything if allocation tracking is not compiled in
+int AllocationReport(const int& calls) {
+
+	if (!Allocations::Tracking()) {
+		std::cout << "Allocation tracking is not compiled in, define ALLOCATION_TRACKING to count allocations" << endl;
+		return -1;
+	}
+
+	const int n = 256;
+
+	EuropeanOption EO(65, 0.25, 0.08, 0.08, 0.3, 0);
+	PerpetualAmericanOption PAO(100, 0.1, 0.02, 0.1, 0);
+	Greeks g(EO, 60);
+
+	std::vector<double> S(n, 60), K(n, 65), T(n, 0.25), r(n, 0.08), b(n, 0.08), sig(n, 0.3), H(n, 50), R(n, 1), cash(n, 1);
+	std::vector<double> out1(n), out2(n), out3(n), out4(n), out5(n), out6(n), out7(n);
+	std::vector<float> fS(n, 60), fK(n, 65), fT(n, 0.25f), fr(n, 0.08f), fb(n, 0.08f), fsig(n, 0.3f), fout1(n), fout2(n), fout3(n);
+	std::vector<double> spots(10, 60);
+	double base[6] = { 60, 65, 0.25, 0.08, 0.08, 0.3 };
+
+	std::vector<OptionRecord> records;
+
+	for (int i = 0; i < n; ++i) {
+		records.push_back(i % 2 ? Record(60, EO) : Record(110, PAO));
+	}
+
+	Matrix matrix(EO, 50, 0, 100, n - 1);
+	Sweep sweep(EO, 50, 0, 100, n - 1);
+	SensitivityEngine sensitivities;
+	BumpGreeks bump(EO, 1e-8);
+	OptionBook book(records);
+
+	ScenarioEngine scenario_engine(4);
+	TimeProjection projection(4);
+	std::vector<Scenario> scenarios(n);
+	std::vector<double> dates(8);
+
+	for (int i = 0; i < n; ++i) {
+		scenario_engine.AddPosition(EO, 40 + 0.1 * i, 1);
+		projection.AddPosition(EO, 40 + 0.1 * i, 1);
+		Scenario scenario = { 0.001 * (i % 21 - 10), 0.01 * (i % 5), 0.001 * (i % 3) };
+		scenarios[i] = scenario;
+	}
+
+	for (int i = 0; i < 8; ++i) {
+		dates[i] = 0.025 * i;
+	}
+
+	GridPricer grid(EO, 60, 0, S, 5, sig, 4);
+	ChebyshevProxy proxy(EO, 30, 90, 32, 1e-6);
+	ShardedBook sharded(records, NUMA_LOCAL);
+
+	// The snapshot is mapped for the report and removed once the file is no longer needed
+	const std::string snapshot_path = "allocations.snapshot";
+	WriteSnapshot(snapshot_path, records);
+	BookSnapshot snapshot(snapshot_path);
+
+	std::vector<AllocationCase> cases = {
+		{ "EuropeanOption::Price", true, [&] { sink = EO.Price(60); } },
+		{ "EuropeanOption::Delta", true, [&] { sink = EO.Delta(60); } },
+		{ "EuropeanOption::Gamma", true, [&] { sink = EO.Gamma(60); } },
+		{ "EuropeanOption::Delta(S, h)", true, [&] { sink = EO.Delta(60, 0.01); } },
+		{ "EuropeanOption::Gamma(S, h)", true, [&] { sink = EO.Gamma(60, 0.01); } },
+		{ "EuropeanOption::HigherGreeks", true, [&] { sink = EO.HigherGreeks(60).vanna; } },
+		{ "EuropeanOption::PCP_Price", true, [&] { sink = EO.PCP_Price(60); } },
+		{ "PerpetualAmericanOption::Price", true, [&] { sink = PAO.Price(110); } },
+		{ "Greeks::Delta", true, [&] { sink = g.Delta(60); } },
+		{ "Greeks::Gamma", true, [&] { sink = g.Gamma(60); } },
+		{ "PriceBatch (double)", true, [&] { PriceBatch(n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &out1[0], &out2[0]); } },
+		{ "PriceBatch (float)", true, [&] { PriceBatch(n, &fS[0], &fK[0], &fT[0], &fr[0], &fb[0], &fsig[0], &fout1[0], &fout2[0]); } },
+		{ "PriceBatchMixed", true, [&] { PriceBatchMixed(n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &out1[0], &out2[0]); } },
+		{ "GreeksBatch (double)", true, [&] { GreeksBatch(n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &out1[0], &out2[0], &out3[0]); } },
+		{ "GreeksBatch (float)", true, [&] { GreeksBatch(n, &fS[0], &fK[0], &fT[0], &fr[0], &fb[0], &fsig[0], &fout1[0], &fout2[0], &fout3[0]); } },
+		{ "HigherGreeksBatch", true, [&] { HigherGreeksBatch(n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &out1[0], &out2[0], &out3[0], &out4[0], &out5[0], &out6[0], &out7[0]); } },
+		{ "DigitalBatch", true, [&] { DigitalBatch(n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &cash[0], &out1[0], &out2[0], &out3[0], &out4[0]); } },
+		{ "BarrierBatch", true, [&] { BarrierBatch(n, BARRIER_DOWN_OUT, true, &S[0], &K[0], &H[0], &R[0], &T[0], &r[0], &b[0], &sig[0], &out1[0]); } },
+		{ "SweepBatch", true, [&] { SweepBatch(n, 0, base, &S[0], &out1[0], &out2[0]); } },
+		{ "PriceRecords", true, [&] { PriceRecords(n, &records[0], &out1[0]); } },
+		{ "GreeksRecords", true, [&] { GreeksRecords(n, &records[0], &out1[0], &out2[0]); } },
+		{ "Matrix::MatrixPricer(buffers)", true, [&] { matrix.MatrixPricer(&out1[0], &out2[0]); } },
+		{ "Matrix::MatrixPricer(g, buffers)", true, [&] { matrix.MatrixPricer(g, &out1[0], &out2[0], &out3[0]); } },
+		{ "Sweep::MatrixPricer(buffers)", true, [&] { sweep.MatrixPricer(&out1[0], &out2[0]); } },
+		{ "Sweep::MatrixPricer(g, buffers)", true, [&] { sweep.MatrixPricer(g, &out1[0], &out2[0], &out3[0]); } },
+		{ "OptionBook::Price", true, [&] { book.Price(&out1[0]); } },
+		{ "OptionBook::Greeks", true, [&] { book.Greeks(&out1[0], &out2[0]); } },
+		{ "BumpGreeks::Spot", true, [&] { sink = bump.Spot(60).first; } },
+		{ "BumpGreeks::Volatility", true, [&] { sink = bump.Volatility(60).first; } },
+		{ "BumpGreeks::All", true, [&] { sink = bump.All(60).time.first; } },
+		{ "BookSnapshot::Price", true, [&] { snapshot.Price(&out1[0]); } },
+		{ "ShardedBook::Price", true, [&] { sharded.Price(&out1[0]); } },
+		{ "ChebyshevProxy::Price", true, [&] { sink = proxy.Price(60); } },
+		{ "ChebyshevProxy::Delta", true, [&] { sink = proxy.Delta(60); } },
+		{ "ChebyshevProxy::PriceScenarios", true, [&] { proxy.PriceScenarios(&S[0], &out1[0], n); } },
+		{ "ChebyshevProxy::DeltaScenarios", true, [&] { proxy.DeltaScenarios(&S[0], &out1[0], n); } },
+		{ "ScenarioEngine::Revalue", true, [&] { sink = scenario_engine.Revalue(scenarios)[0]; } },
+		{ "GridPricer::Compute", true, [&] { grid.Compute(); } },
+		{ "TimeProjection::Project", true, [&] { projection.Project(dates); } },
+		{ "EuropeanOption::Description", false, [&] { sink = EO.Description().size(); } },
+		{ "EuropeanOption::SpotPricePricer", false, [&] { sink = boost::tuples::get<1>(EO.SpotPricePricer(spots))[0]; } },
+		{ "PerpetualAmericanOption::SpotPricePricer", false, [&] { sink = boost::tuples::get<1>(PAO.SpotPricePricer(spots))[0]; } },
+		{ "Greeks::SpotPricePricer", false, [&] { sink = boost::tuples::get<1>(g.SpotPricePricer(spots))[0]; } },
+		{ "Matrix::MatrixPricer()", false, [&] { sink = boost::tuples::get<0>(matrix.MatrixPricer())[0]; } },
+		{ "Matrix::MatrixPricer(g)", false, [&] { sink = boost::tuples::get<0>(matrix.MatrixPricer(g))[0]; } },
+		{ "Sweep::MatrixPricer()", false, [&] { sink = boost::tuples::get<0>(sweep.MatrixPricer())[0]; } },
+		{ "SensitivityEngine::Compute", false, [&] { sensitivities.Compute(matrix); } }
+	};
+
+	int failures = 0;
+
+	std::cout << "API:" << '\t' << '\t' << '\t' << '\t' << "Allocations per call:" << '\t' << "Bytes per call:" << '\t' << "Certified:" << endl;
+
+	for (std::size_t i = 0; i < cases.size(); ++i) {
+
+		cases[i].call();
+
+		unsigned long long count = Allocations::TotalCount(), bytes = Allocations::TotalBytes();
+
+		for (int k = 0; k < calls; ++k) {
+			cases[i].call();
+		}
+
+		double per_call = double(Allocations::TotalCount() - count) / calls;
+		double bytes_per_call = double(Allocations::TotalBytes() - bytes) / calls;
+
+		std::string status = "-";
+
+		if (cases[i].core) {
+			status = per_call == 0 ? "yes" : "FAILED";
+			failures += per_call != 0;
+		}
+
+		std::cout << cases[i].name << std::string(cases[i].name.size() < 32 ? 32 - cases[i].name.size() : 1, ' ') << '\t' << per_call << '\t' << '\t' << '\t' << bytes_per_call << '\t' << '\t' << status << endl;
+	}
+
+	std::cout << failures << " core paths allocated" << endl;
+
+	std::remove(snapshot_path.c_str());
+
+	return failures;
+}
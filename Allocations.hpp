@@ -0,0 +1,50 @@
+// Objective: Create the Allocations class that counts the heap allocations of the calling thread and of the process, and the allocation report of the pricing APIs
+
+// Ensure no errors if the header file is used twice
+#ifndef ALLOCATIONS_HPP
+#define ALLOCATIONS_HPP
+
+// Include header files
+#include <iostream>
+using namespace std;
+
+
+
+// Allocation tracking is toggled at compile time by defining ALLOCATION_TRACKING
+// With it, Allocations.cpp replaces the global operator new and operator delete with versions that count every allocation of each thread, and of the whole process
+// Without it the global operators are the ones of the standard library, and every count stays at 0
+
+
+
+// Create the Allocations class
+// The class only has static methods since the counters belong to the threads and the process, not to objects
+class Allocations {
+public:
+
+	// Returns true if the tracking operators are compiled in
+	static bool Tracking();
+
+	// Returns the number of heap allocations and the bytes allocated by the calling thread so far
+	static unsigned long long Count();
+	static unsigned long long Bytes();
+
+	// Returns the number of heap allocations and the bytes allocated by every thread of the process so far
+	// These see the allocations of the Scheduler workers and of the other threads that an API hands its work to
+	static unsigned long long TotalCount();
+	static unsigned long long TotalBytes();
+
+};
+
+
+// A global function that measures the heap allocations per call of every public pricing and greeks API and outputs them as a table
+// Each API is called once to warm it up and then calls more times, and the allocations of the whole process in between are divided by calls,
+// so the allocations of the threads that an API hands its work to, such as the Scheduler workers, are counted as well
+// The core paths, the Price, Delta, and Gamma methods, the batch kernels, the record pricers, the OptionBook, the buffer MatrixPricers,
+// and the books and engines that reuse their results from call to call, are certified allocation-free,
+// and the function returns the number of core paths that allocated, so a caller can fail when an allocation creeps back in
+// It returns -1 if the program is not compiled with ALLOCATION_TRACKING, so a check that cannot count does not pass
+int AllocationReport(const int& calls);
+
+
+
+#endif
@@ -0,0 +1,106 @@
+// Objective: Implement the Arena class
+
+// Include the necessary header files
+#include "Arena.hpp"
+#include <iostream>
+using namespace std;
+#include <vector>
+#include <cstddef>
+
+
+
+// Default constructor
+// Blocks are 1 MB by default
+Arena::Arena() : m_blocks(), m_sizes(), m_block_size(1 << 20), m_block(0), m_offset(0), m_used(0), m_peak(0) {}
+
+
+// Parameter constructor
+Arena::Arena(std::size_t block_size) : m_blocks(), m_sizes(), m_block_size(block_size), m_block(0), m_offset(0), m_used(0), m_peak(0) {}
+
+
+// Destructor
+// Frees every block
+Arena::~Arena() {
+	for (int i = 0; i < m_blocks.size(); ++i) {
+		delete[] m_blocks[i];
+	}
+}
+
+
+// Returns a pointer to the given number of bytes aligned to align
+// If the current block is full, the next free block that fits is used, and a new block is only created when none fit
+void* Arena::Allocate(std::size_t bytes, std::size_t align) {
+
+	// Look for a block with enough room, starting at the current one
+	while (m_block < m_blocks.size()) {
+
+		// Align the offset within the block
+		std::size_t start = (reinterpret_cast<std::size_t>(m_blocks[m_block]) + m_offset + align - 1) & ~(align - 1);
+		start -= reinterpret_cast<std::size_t>(m_blocks[m_block]);
+
+		if (start + bytes <= m_sizes[m_block]) {
+
+			m_offset = start + bytes;
+			m_used += bytes;
+
+			if (m_used > m_peak) {
+				m_peak = m_used;
+			}
+
+			return m_blocks[m_block] + start;
+		}
+
+		// Move on to the next block
+		++m_block;
+		m_offset = 0;
+	}
+
+	// No block fits, so create one that is large enough for the request
+	std::size_t size = m_block_size;
+
+	if (bytes + align > size) {
+		size = bytes + align;
+	}
+
+	m_blocks.push_back(new char[size]);
+	m_sizes.push_back(size);
+
+	m_block = m_blocks.size() - 1;
+	m_offset = 0;
+
+	return this->Allocate(bytes, align);
+}
+
+
+// Makes all of the blocks available again
+// The blocks are kept, so the next sweep does not call the global allocator at all
+void Arena::Reset() {
+	m_block = 0;
+	m_offset = 0;
+	m_used = 0;
+}
+
+
+// Returns the number of bytes handed out since the last reset
+std::size_t Arena::Used() const {
+	return m_used;
+}
+
+
+// Returns the largest number of bytes handed out between two resets
+std::size_t Arena::Peak() const {
+	return m_peak;
+}
+
+
+// Returns the total size of the blocks owned by the Arena
+std::size_t Arena::Capacity() const {
+
+	std::size_t total = 0;
+
+	for (int i = 0; i < m_sizes.size(); ++i) {
+		total += m_sizes[i];
+	}
+
+	return total;
+}
@@ -0,0 +1,130 @@
+// Objective: Create the Arena class and the ArenaAllocator class that draws from it
+
+// Ensure no errors if the header file is used twice
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+// Include header files
+#include <iostream>
+#include <vector>
+#include <cstddef>
+using namespace std;
+
+
+
+// Create the Arena class
+// An Arena hands out memory from large blocks by moving an offset forward, and individual allocations are never freed
+// Reset() makes all of the memory available again in O(1) time, so the blocks are reused from one sweep to the next
+// An Arena is meant to be used by one thread at a time
+class Arena {
+private:
+
+	// The blocks owned by the Arena and their sizes
+	std::vector<char*> m_blocks;
+	std::vector<std::size_t> m_sizes;
+
+	// The default size of a new block
+	std::size_t m_block_size;
+
+	// The block that is currently being used and the offset into it
+	int m_block;
+	std::size_t m_offset;
+
+	// The bytes handed out since the last reset and the largest amount ever handed out between two resets
+	std::size_t m_used;
+	std::size_t m_peak;
+
+	// Arenas own their blocks and cannot be copied
+	Arena(const Arena& source);
+	Arena& operator = (const Arena& source);
+
+public:
+
+	// Default constructor
+	Arena();
+
+	// Parameter constructor with the default size of a block in bytes
+	Arena(std::size_t block_size);
+
+	// Destructor
+	virtual ~Arena();
+
+	// Returns a pointer to the given number of bytes aligned to align
+	void* Allocate(std::size_t bytes, std::size_t align);
+
+	// Returns an array of n objects of type T, which are left uninitialized
+	template <typename T>
+	T* Allocate(const int& n) {
+		return static_cast<T*>(this->Allocate(n * sizeof(T), alignof(T)));
+	}
+
+	// Makes all of the blocks available again without freeing them
+	void Reset();
+
+	// Accessors for the usage of the Arena
+	std::size_t Used() const;
+	std::size_t Peak() const;
+	std::size_t Capacity() const;
+
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the ArenaAllocator class
+// A standard allocator that draws from an Arena, so that containers such as std::vector can be placed in an Arena
+// An ArenaAllocator without an Arena uses the global operator new and delete, which keeps containers usable without an Arena
+template <typename T>
+class ArenaAllocator {
+public:
+
+	typedef T value_type;
+
+	// The Arena that is drawn from, or null for the global heap
+	Arena* m_arena;
+
+	// Default constructor
+	ArenaAllocator() : m_arena(0) {}
+
+	// Parameter constructor
+	ArenaAllocator(Arena* arena) : m_arena(arena) {}
+
+	// Converting copy constructor used by the containers
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& source) : m_arena(source.m_arena) {}
+
+	// Allocates n objects of type T
+	T* allocate(std::size_t n) {
+
+		if (m_arena != 0) {
+			return static_cast<T*>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+		}
+
+		return static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+
+	// Deallocation is a no-op for an Arena, the memory is reclaimed by Reset()
+	void deallocate(T* p, std::size_t) {
+
+		if (m_arena == 0) {
+			::operator delete(p);
+		}
+	}
+
+};
+
+
+// Two ArenaAllocators are equal if they draw from the same Arena
+template <typename T, typename U>
+bool operator == (const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+	return a.m_arena == b.m_arena;
+}
+
+template <typename T, typename U>
+bool operator != (const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+	return a.m_arena != b.m_arena;
+}
+
+
+
+#endif
@@ -0,0 +1,697 @@
+// Objective: Implement the Benchmark class
+
+// Include the necessary header files
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+#include "EuropeanOption.hpp"
+#include "PerpetualAmericanOption.hpp"
+#include "Matrix.hpp"
+#include "Kernels.hpp"
+#include "ChebyshevProxy.hpp"
+#include "QuoteChecks.hpp"
+#include "Serialization.hpp"
+#include "ShardedBook.hpp"
+#include "Scheduler.hpp"
+#include "SensitivityEngine.hpp"
+#include "Sweep.hpp"
+#include "ResultEmitter.hpp"
+#include "OptionBook.hpp"
+#include <iostream>
+using namespace std;
+#include <vector>
+#include <random>
+#include <chrono>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <thread>
+#include <algorithm>
+
+
+
+// The sum of every result of a workload is stored here so that the compiler cannot remove the work
+static volatile double sink = 0;
+
+
+// Returns the steady clock in seconds
+static double Now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+// Parameter constructor
+Benchmark::Benchmark(int n, bool counters) : m_n(n), m_counters(counters), m_perf(), m_start(0) {}
+
+
+// Destructor
+Benchmark::~Benchmark() {}
+
+
+// Starts timing a workload
+void Benchmark::Start() {
+
+	if (m_counters) {
+		m_perf.Start();
+	}
+
+	m_start = Now();
+}
+
+
+// Stops timing a workload and outputs its throughput and counters per operation
+// Counters that are not available are output as n/a
+void Benchmark::Stop(const std::string& name, const double& ops) {
+
+	double seconds = Now() - m_start;
+
+	if (m_counters) {
+		m_perf.Stop();
+	}
+
+	std::cout << name << '\t' << ops / seconds / 1e6 << '\t' << '\t' << seconds * 1e9 / ops;
+
+	if (m_counters) {
+
+		for (int i = 0; i < PERF_EVENTS; ++i) {
+
+			std::cout << '\t' << '\t';
+
+			if (m_perf.Available(i)) {
+				std::cout << m_perf.Value(i) / ops;
+			}
+
+			else {
+				std::cout << "n/a";
+			}
+		}
+
+		std::cout << '\t' << '\t';
+
+		if (m_perf.Available(PERF_CYCLES) && m_perf.Available(PERF_INSTRUCTIONS) && m_perf.Value(PERF_CYCLES) > 0) {
+			std::cout << m_perf.Value(PERF_INSTRUCTIONS) / m_perf.Value(PERF_CYCLES);
+		}
+
+		else {
+			std::cout << "n/a";
+		}
+	}
+
+	std::cout << endl;
+}
+
+
+
+// Prices calls and puts of EuropeanOptions
+// Half of the options are toggled to puts at random, so the OptionType() checks cannot be predicted
+void Benchmark::EuropeanOptions() {
+
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<double> spot(50, 150), strike(50, 150), expiry(0.05, 5), rate(0, 0.1), vol(0.05, 0.8);
+	std::bernoulli_distribution put(0.5);
+
+	std::vector<EuropeanOption> options;
+	std::vector<double> S(m_n), K(m_n), T(m_n), r(m_n), b(m_n), sig(m_n), call(m_n), puts(m_n);
+
+	for (int i = 0; i < m_n; ++i) {
+
+		S[i] = spot(gen);
+		K[i] = strike(gen);
+		T[i] = expiry(gen);
+		r[i] = rate(gen);
+		b[i] = r[i];
+		sig[i] = vol(gen);
+
+		options.push_back(EuropeanOption(K[i], T[i], r[i], b[i], sig[i], 0));
+
+		if (put(gen)) {
+			options[i].Toggle();
+		}
+	}
+
+	double sum = 0;
+
+	this->Start();
+	for (int i = 0; i < m_n; ++i) {
+		sum += options[i].Price(S[i]);
+	}
+	this->Stop("EuropeanOption::Price", m_n);
+
+	this->Start();
+	for (int i = 0; i < m_n; ++i) {
+		sum += options[i].Delta(S[i]) + options[i].Gamma(S[i]);
+	}
+	this->Stop("EuropeanOption greeks", m_n);
+
+	// The batch kernel prices a call and a put per option
+	this->Start();
+	PriceBatch(m_n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &call[0], &puts[0]);
+	this->Stop("PriceBatch (double)", 2.0 * m_n);
+
+	for (int i = 0; i < m_n; ++i) {
+		sum += call[i] + puts[i];
+	}
+
+	// The higher order greeks of both sides come from one evaluation per option
+	std::vector<double> vanna(m_n), volga(m_n), charm_call(m_n), charm_put(m_n), speed(m_n), zomma(m_n), color(m_n);
+
+	this->Start();
+	HigherGreeksBatch(m_n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &vanna[0], &volga[0], &charm_call[0], &charm_put[0], &speed[0], &zomma[0], &color[0]);
+	this->Stop("HigherGreeksBatch (double)", m_n);
+
+	for (int i = 0; i < m_n; ++i) {
+		sum += vanna[i] + volga[i] + charm_call[i] + charm_put[i] + speed[i] + zomma[i] + color[i];
+	}
+
+	sink = sum;
+}
+
+
+
+// Prices calls and puts of PerpetualAmericanOptions
+void Benchmark::PerpetualAmericanOptions() {
+
+	std::mt19937 gen(2);
+	std::uniform_real_distribution<double> spot(50, 150), strike(50, 150), rate(0.02, 0.1), carry(0, 0.02), vol(0.05, 0.8);
+	std::bernoulli_distribution put(0.5);
+
+	std::vector<PerpetualAmericanOption> options;
+	std::vector<double> S(m_n);
+
+	for (int i = 0; i < m_n; ++i) {
+
+		S[i] = spot(gen);
+
+		options.push_back(PerpetualAmericanOption(strike(gen), rate(gen), carry(gen), vol(gen), 0));
+
+		if (put(gen)) {
+			options[i].Toggle();
+		}
+	}
+
+	double sum = 0;
+
+	this->Start();
+	for (int i = 0; i < m_n; ++i) {
+		sum += options[i].Price(S[i]);
+	}
+	this->Stop("PerpetualAmericanOption::Price", m_n);
+
+	sink = sum;
+}
+
+
+
+// Prices cash-or-nothing and asset-or-nothing calls and puts, and down-and-out calls, through the batch kernels
+void Benchmark::Exotics() {
+
+	std::mt19937 gen(2);
+	std::uniform_real_distribution<double> spot(50, 150), strike(50, 150), barrier(0.5, 0.95), expiry(0.05, 5), rate(0, 0.1), carry(-0.05, 0.1), vol(0.05, 0.8);
+
+	std::vector<double> S(m_n), K(m_n), H(m_n), R(m_n, 1), T(m_n), r(m_n), b(m_n), sig(m_n), cash(m_n, 1);
+	std::vector<double> cash_call(m_n), cash_put(m_n), asset_call(m_n), asset_put(m_n), out(m_n);
+
+	for (int i = 0; i < m_n; ++i) {
+		S[i] = spot(gen);
+		K[i] = strike(gen);
+		H[i] = S[i] * barrier(gen);
+		T[i] = expiry(gen);
+		r[i] = rate(gen);
+		b[i] = carry(gen);
+		sig[i] = vol(gen);
+	}
+
+	// The digital kernel prices 4 options per set of parameters
+	this->Start();
+	DigitalBatch(m_n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &cash[0], &cash_call[0], &cash_put[0], &asset_call[0], &asset_put[0]);
+	this->Stop("DigitalBatch (double)", 4.0 * m_n);
+
+	this->Start();
+	BarrierBatch(m_n, BARRIER_DOWN_OUT, true, &S[0], &K[0], &H[0], &R[0], &T[0], &r[0], &b[0], &sig[0], &out[0]);
+	this->Stop("BarrierBatch (double)", m_n);
+
+	double sum = 0;
+
+	for (int i = 0; i < m_n; ++i) {
+		sum += cash_call[i] + cash_put[i] + asset_call[i] + asset_put[i] + out[i];
+	}
+
+	sink = sum;
+}
+
+
+
+// Builds and prices spot sweeps with the Matrix class, and sweeps of each parameter through the sweep kernels against the option classes
+// Each row of a sweep is priced as a call and as a put
+void Benchmark::Matrices() {
+
+	EuropeanOption EO(65, 0.25, 0.08, 0.08, 0.3, 0);
+	PerpetualAmericanOption PAO(100, 0.1, 0.02, 0.1, 0);
+
+	std::vector<double> calls(m_n + 1), puts(m_n + 1);
+
+	this->Start();
+	Matrix m1(EO, 50, 0, 100, m_n);
+	this->Stop("Matrix (EO) construction", m_n + 1);
+
+	this->Start();
+	m1.MatrixPricer(&calls[0], &puts[0]);
+	this->Stop("Matrix (EO) MatrixPricer", 2.0 * (m_n + 1));
+
+	// The same spot sweep from a Sweep, which generates the rows while it prices them
+	Sweep compact(EO, 50, 0, 100, m_n);
+
+	this->Start();
+	compact.MatrixPricer(&calls[0], &puts[0]);
+	this->Stop("Sweep (EO) MatrixPricer", 2.0 * (m_n + 1));
+
+	// One operation is a row with every sensitivity of its call and put
+	SensitivityEngine sensitivities;
+
+	this->Start();
+	sensitivities.Compute(m1);
+	this->Stop("SensitivityEngine (EO)", m_n + 1);
+
+	sink = sensitivities.Table()[0];
+
+	this->Start();
+	Matrix m2(PAO, 110, 0, 146, m_n);
+	this->Stop("Matrix (PAO) construction", m_n + 1);
+
+	this->Start();
+	m2.MatrixPricer(&calls[0], &puts[0]);
+	this->Stop("Matrix (PAO) MatrixPricer", 2.0 * (m_n + 1));
+
+	sink = calls[m_n] + puts[m_n];
+
+	// A sweep of each EuropeanOption parameter, priced by its sweep kernel and by the option classes through a Matrix of the same rows
+	const char* names[6] = { "S", "K", "T", "r", "b", "sig" };
+	double ends[6] = { 100, 100, 2, 0.2, 0.2, 0.8 };
+
+	for (int k = 0; k < 6; ++k) {
+
+		Matrix sweep(EO, 60, k, ends[k], m_n);
+
+		std::vector<Vector> rows;
+		rows.reserve(m_n + 1);
+
+		for (int i = 0; i <= m_n; ++i) {
+			rows.push_back(static_cast<const Matrix&>(sweep)[i]);
+		}
+
+		Matrix generic(rows);
+
+		this->Start();
+		generic.MatrixPricer(&calls[0], &puts[0]);
+		this->Stop(std::string("Sweep ") + names[k] + " (generic)", 2.0 * (m_n + 1));
+
+		this->Start();
+		sweep.MatrixPricer(&calls[0], &puts[0]);
+		this->Stop(std::string("Sweep ") + names[k] + " (kernel)", 2.0 * (m_n + 1));
+
+		sink = calls[m_n] + puts[m_n];
+	}
+}
+
+
+
+// Revalues one position under spot scenarios exactly and through a ChebyshevProxy
+void Benchmark::Proxies() {
+
+	EuropeanOption EO(65, 0.25, 0.08, 0.08, 0.3, 0);
+	ChebyshevProxy proxy(EO, 30, 90, 24, 1e-6);
+
+	std::mt19937 gen(3);
+	std::uniform_real_distribution<double> spot(30, 90);
+
+	std::vector<double> S(m_n), out(m_n);
+
+	for (int i = 0; i < m_n; ++i) {
+		S[i] = spot(gen);
+	}
+
+	this->Start();
+	for (int i = 0; i < m_n; ++i) {
+		out[i] = EO.Price(S[i]);
+	}
+	this->Stop("Exact scenarios", m_n);
+
+	double sum = out[m_n - 1];
+
+	this->Start();
+	proxy.PriceScenarios(&S[0], &out[0], m_n);
+	this->Stop("Proxy scenarios", m_n);
+
+	sink = sum + out[m_n - 1];
+}
+
+
+
+// Checks call and put quotes for put-call parity and no-arbitrage violations
+// The quotes are chains of 20 strikes priced by the batch kernel
+void Benchmark::QuoteChecks() {
+
+	std::vector<double> S(m_n), K(m_n), T(m_n), r(m_n), b(m_n), sig(m_n), call(m_n), put(m_n);
+	std::vector<unsigned char> flags(m_n);
+
+	for (int i = 0; i < m_n; ++i) {
+
+		int chain = i / 20;
+
+		S[i] = 100;
+		K[i] = 80 + 2 * (i % 20);
+		T[i] = 0.1 + 0.01 * (chain % 100);
+		r[i] = 0.05;
+		b[i] = 0.05;
+		sig[i] = 0.3;
+	}
+
+	PriceBatch(m_n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &call[0], &put[0]);
+
+	this->Start();
+	CheckQuotes(m_n, &call[0], &put[0], &S[0], &K[0], &T[0], &r[0], &b[0], 1e-8, &flags[0]);
+	this->Stop("CheckQuotes", m_n);
+
+	sink = flags[m_n - 1];
+}
+
+
+
+// Writes a book of EuropeanOptions as a snapshot and as text
+// The snapshot is mapped and priced in place, and the text is parsed back into EuropeanOptions and priced
+void Benchmark::Snapshots() {
+
+	std::vector<OptionRecord> records(m_n);
+	std::stringstream text;
+
+	for (int i = 0; i < m_n; ++i) {
+
+		EuropeanOption option(80 + (i % 40), 0.1 + 0.01 * (i % 100), 0.05, 0.05, 0.3, 0);
+
+		if (i % 2) {
+			option.Toggle();
+		}
+
+		records[i] = Record(100.0, option);
+		text << 100.0 << ' ' << option.StrikePrice() << ' ' << option.Expiry() << ' ' << option.RiskFreeRate() << ' ' << option.CostOfCarry() << ' ' << option.Volatility() << ' ' << option.Dividend() << ' ' << i % 2 << '\n';
+	}
+
+	WriteSnapshot("bench.snapshot", records);
+
+	std::vector<double> out(m_n);
+
+	this->Start();
+	{
+		BookSnapshot snapshot("bench.snapshot");
+		snapshot.Price(&out[0]);
+	}
+	this->Stop("MappedSnapshot", m_n);
+
+	sink = out[m_n - 1];
+
+	this->Start();
+	for (int i = 0; i < m_n; ++i) {
+
+		double S, K, T, r, b, sig, q;
+		int put;
+
+		text >> S >> K >> T >> r >> b >> sig >> q >> put;
+
+		EuropeanOption option(K, T, r, b, sig, q);
+
+		if (put) {
+			option.Toggle();
+		}
+
+		out[i] = option.Price(S);
+	}
+	this->Stop("ParsedText", m_n);
+
+	sink = out[m_n - 1];
+
+	std::remove("bench.snapshot");
+}
+
+
+
+// Prices a book of EuropeanOptions in the local and interleaved layouts
+// Each layout is priced once before it is timed, so the pages are mapped and the workers are running
+void Benchmark::Shards() {
+
+	std::vector<OptionRecord> records(m_n);
+
+	for (int i = 0; i < m_n; ++i) {
+		OptionRecord rec = { 100, 80.0 + (i % 40), 0.1 + 0.01 * (i % 100), 0.05, 0.05, 0.3, 0, RECORD_EO, unsigned(i % 2) };
+		records[i] = rec;
+	}
+
+	std::vector<double> out(m_n);
+	const int reps = 4;
+
+	ShardedBook local(records, NUMA_LOCAL);
+	local.Price(&out[0]);
+
+	this->Start();
+	for (int k = 0; k < reps; ++k) {
+		local.Price(&out[0]);
+	}
+	this->Stop("ShardedLocal", double(reps) * m_n);
+
+	sink = out[m_n - 1];
+
+	ShardedBook interleaved(records, NUMA_INTERLEAVED);
+	interleaved.Price(&out[0]);
+
+	this->Start();
+	for (int k = 0; k < reps; ++k) {
+		interleaved.Price(&out[0]);
+	}
+	this->Stop("ShardedInterleaved", double(reps) * m_n);
+
+	sink = out[m_n - 1];
+
+	std::cout << "NUMA nodes: " << local.Nodes() << ", workers: " << local.Workers() << endl;
+}
+
+
+
+// Prices a book with a few options that cost far more than the rest
+// The expensive options are bunched at the front of the book, so a static split gives nearly all of the work to the first thread
+void Benchmark::MixedBook() {
+
+	std::vector<EuropeanOption> book(m_n);
+	std::vector<double> out(m_n);
+
+	for (int i = 0; i < m_n; ++i) {
+		book[i] = EuropeanOption(80.0 + (i % 40), 0.1 + 0.01 * (i % 100), 0.05, 0.05, 0.3, 0);
+		if (i % 2) book[i].Toggle();
+	}
+
+	int heavy = m_n / 64;
+
+	// The expensive options sum the finite difference gammas over a ladder of steps
+	auto price = [&](int first, int last) {
+
+		for (int i = first; i < last; ++i) {
+
+			double value = book[i].Price(100);
+
+			if (i < heavy) {
+				for (int k = 1; k <= 200; ++k) {
+					value += book[i].Gamma(100, 0.01 * k);
+				}
+			}
+
+			out[i] = value;
+		}
+	};
+
+	int threads = max(1, int(std::thread::hardware_concurrency()));
+
+	this->Start();
+	{
+		std::vector<std::thread> workers;
+		int chunk = (m_n + threads - 1) / threads;
+
+		for (int t = 1; t < threads; ++t) {
+			workers.push_back(std::thread(price, min(m_n, t * chunk), min(m_n, (t + 1) * chunk)));
+		}
+
+		price(0, min(m_n, chunk));
+
+		for (std::size_t t = 0; t < workers.size(); ++t) {
+			workers[t].join();
+		}
+	}
+	this->Stop("MixedStatic", m_n);
+
+	sink = out[0] + out[m_n - 1];
+
+	Scheduler& scheduler = Scheduler::Global();
+	scheduler.ResetStatistics();
+
+	this->Start();
+	scheduler.ParallelFor(0, m_n, 256, price);
+	this->Stop("MixedStealing", m_n);
+
+	sink = out[0] + out[m_n - 1];
+
+	scheduler.OutputStatistics();
+}
+
+
+
+// Prices a book whose options are EuropeanOptions and PerpetualAmericanOptions, calls and puts, in random order
+// through the Option base class one option at a time, through the record pricers, and through an OptionBook
+void Benchmark::Books() {
+
+	std::mt19937 gen(6);
+	std::uniform_real_distribution<double> spot(80, 120), strike(80, 120), expiry(0.1, 2), vol(0.1, 0.5);
+	std::bernoulli_distribution perpetual(0.5), put(0.5);
+
+	std::vector<EuropeanOption> europeans;
+	std::vector<PerpetualAmericanOption> perpetuals;
+	std::vector<OptionRecord> records(m_n);
+	std::vector<double> S(m_n), out(m_n);
+
+	europeans.reserve(m_n);
+	perpetuals.reserve(m_n);
+
+	std::vector<const Option*> options(m_n);
+
+	for (int i = 0; i < m_n; ++i) {
+
+		S[i] = spot(gen);
+
+		if (perpetual(gen)) {
+
+			perpetuals.push_back(PerpetualAmericanOption(strike(gen), 0.08, 0.02, vol(gen), 0));
+			if (put(gen)) perpetuals.back().Toggle();
+
+			options[i] = &perpetuals.back();
+			records[i] = Record(S[i], perpetuals.back());
+		}
+
+		else {
+
+			europeans.push_back(EuropeanOption(strike(gen), expiry(gen), 0.05, 0.05, vol(gen), 0));
+			if (put(gen)) europeans.back().Toggle();
+
+			options[i] = &europeans.back();
+			records[i] = Record(S[i], europeans.back());
+		}
+	}
+
+	this->Start();
+	for (int i = 0; i < m_n; ++i) {
+		out[i] = options[i]->Price(S[i]);
+	}
+	this->Stop("Option::Price (mixed book)", m_n);
+
+	sink = out[m_n - 1];
+
+	this->Start();
+	PriceRecords(m_n, &records[0], &out[0]);
+	this->Stop("PriceRecords (mixed book)", m_n);
+
+	sink = out[m_n - 1];
+
+	this->Start();
+	OptionBook book(records);
+	this->Stop("OptionBook grouping", m_n);
+
+	this->Start();
+	book.Price(&out[0]);
+	this->Stop("OptionBook::Price", m_n);
+
+	sink = out[m_n - 1];
+}
+
+
+
+// Writes a call and a put per row to a file, as the ReadTuple loops do through std::cout, and through a serial and a parallel ResultEmitter
+// One operation is one value, and the throughput in MB/s is output after each way
+void Benchmark::Emitters() {
+
+	std::vector<double> calls(m_n), puts(m_n);
+
+	for (int i = 0; i < m_n; ++i) {
+		calls[i] = 10 + 0.001 * i;
+		puts[i] = 1.0 / (1 + i);
+	}
+
+	std::ifstream::pos_type bytes;
+
+	this->Start();
+	{
+		std::ofstream os("bench.csv");
+
+		for (int i = 0; i < m_n; ++i) {
+			os << calls[i] << endl;
+			os << puts[i] << endl;
+		}
+
+		bytes = os.tellp();
+	}
+	this->Stop("ofstream with endl", 2.0 * m_n);
+
+	std::cout << "MB: " << double(bytes) / 1e6 << endl;
+
+	for (int parallel = 0; parallel < 2; ++parallel) {
+
+		double start = Now();
+		unsigned long long written;
+
+		this->Start();
+		{
+			ResultEmitter emitter("bench.csv", CSV, 6, parallel == 1);
+			emitter.Columns(m_n, { &calls[0], &puts[0] }, false);
+			emitter.Flush();
+			written = emitter.Bytes();
+		}
+		this->Stop(parallel ? "ResultEmitter (parallel)" : "ResultEmitter (serial)", 2.0 * m_n);
+
+		std::cout << "MB: " << written / 1e6 << ", MB/s: " << written / 1e6 / (Now() - start) << endl;
+	}
+
+	std::remove("bench.csv");
+}
+
+
+
+// Outputs the header and runs every workload
+void Benchmark::Run() {
+
+	std::cout << "Benchmarks with " << m_n << " operations per workload" << endl;
+
+	if (m_counters && !m_perf.Available()) {
+		std::cout << "Hardware counters are not available on this machine" << endl;
+	}
+
+	std::cout << "Workload:" << '\t' << '\t' << "Mops/s:" << '\t' << '\t' << "ns/op:";
+
+	if (m_counters) {
+
+		for (int i = 0; i < PERF_EVENTS; ++i) {
+			std::cout << '\t' << '\t' << PerfCounters::Name(i) << "/op:";
+		}
+
+		std::cout << '\t' << '\t' << "IPC:";
+	}
+
+	std::cout << endl;
+
+	this->EuropeanOptions();
+	this->PerpetualAmericanOptions();
+	this->Exotics();
+	this->Matrices();
+	this->Proxies();
+	this->QuoteChecks();
+	this->Snapshots();
+	this->Shards();
+	this->MixedBook();
+	this->Books();
+	this->Emitters();
+
+	std::cout << endl;
+}
@@ -0,0 +1,90 @@
+// Objective: Create the Benchmark class that measures the throughput of the pricing workloads
+
+// Ensure no errors if the header file is used twice
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+// Include header files
+#include "PerfCounters.hpp"
+#include <iostream>
+#include <string>
+using namespace std;
+
+
+
+// Create the Benchmark class
+// Each workload is timed with the steady clock, and the hardware counters are read around it when they are enabled
+class Benchmark {
+private:
+
+	// The number of operations of each workload
+	int m_n;
+
+	// True if the hardware counters are read around each workload
+	bool m_counters;
+
+	// The hardware counters of the thread that runs the benchmarks and of the threads it starts, such as the workers of the parallel workloads
+	PerfCounters m_perf;
+
+	// Starts timing a workload
+	void Start();
+
+	// Stops timing a workload and outputs its throughput and counters per operation
+	void Stop(const std::string& name, const double& ops);
+
+	// The start of the workload that is being timed
+	double m_start;
+
+	// Benchmarks own their counters and cannot be copied
+	Benchmark(const Benchmark& source);
+	Benchmark& operator = (const Benchmark& source);
+
+public:
+
+	// Parameter constructor with the number of operations of each workload and whether to read the hardware counters
+	Benchmark(int n, bool counters);
+
+	// Destructor
+	virtual ~Benchmark();
+
+	// Prices calls and puts of EuropeanOptions one at a time, and through the batch kernels
+	void EuropeanOptions();
+
+	// Prices calls and puts of PerpetualAmericanOptions
+	void PerpetualAmericanOptions();
+
+	// Prices digital and barrier options through their batch kernels
+	void Exotics();
+
+	// Builds and prices spot sweeps with the Matrix class, and sweeps of each parameter through the sweep kernels against the option classes
+	void Matrices();
+
+	// Revalues one position under spot scenarios exactly and through a ChebyshevProxy
+	void Proxies();
+
+	// Checks call and put quotes for put-call parity and no-arbitrage violations
+	void QuoteChecks();
+
+	// Writes a book snapshot, then maps and prices it, against reading the same book back from text
+	void Snapshots();
+
+	// Prices a ShardedBook with its options on the node of each worker, against the same book with its pages interleaved across the nodes
+	void Shards();
+
+	// Prices a book where every 64th option is revalued over a ladder of finite difference gammas, split statically across threads against handed to the Scheduler
+	void MixedBook();
+
+	// Prices a book of mixed option styles and sides through the Option base class, through the record pricers, and through an OptionBook
+	void Books();
+
+	// Writes prices as text through an ofstream with endl per value, against a ResultEmitter
+	void Emitters();
+
+	// Outputs the header and runs every workload
+	void Run();
+
+};
+
+
+
+#endif
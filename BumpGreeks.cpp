@@ -0,0 +1,286 @@
+// Objective: Implement the BumpGreeks class
+
+// Include the necessary header files
+#include "BumpGreeks.hpp"
+#include "Option.hpp"
+#include <iostream>
+using namespace std;
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+
+
+// The fraction of the scale of a parameter used as the first step
+static const double FIRST_STEP = 0.01;
+
+// Ridders' rule: the table is abandoned once its error is this many times the best error so far, since the differences have started to cancel
+static const double DIVERGENCE = 2.0;
+
+// The smallest first steps of the rates, which can be 0, and of the spot price
+static const double RATE_SCALE = 0.1;
+static const double SPOT_SCALE = 1.0;
+
+// The most steps of a table, which is kept on the stack so that a bump does not allocate
+// Each step halves the step size, so 16 steps already go from 1% to about 3e-7 of the scale
+static const int MAX_LEVELS = 16;
+
+
+
+// Default constructor
+BumpGreeks::BumpGreeks() : m_model([](const double&, const BumpParameters&) { return 0.0; }), m_base(), m_tolerance(1e-8), m_levels(8) {}
+
+
+// Parameter constructor with the price of the model at a spot price
+// Uses at least 2 steps, so that there is always one column of extrapolation, and at most MAX_LEVELS
+BumpGreeks::BumpGreeks(const std::function<double(const double&)>& price, double tolerance, int levels) : m_model([price](const double& S, const BumpParameters&) { return price(S); }), m_base(), m_tolerance(tolerance), m_levels(max(2, min(MAX_LEVELS, levels))) {}
+
+
+// Parameter constructor with the price of the model at a spot price and a set of parameters
+BumpGreeks::BumpGreeks(const std::function<double(const double&, const BumpParameters&)>& model, const BumpParameters& base, double tolerance, int levels) : m_model(model), m_base(base), m_tolerance(tolerance), m_levels(max(2, min(MAX_LEVELS, levels))) {}
+
+
+// Parameter constructor with an Option
+BumpGreeks::BumpGreeks(const Option& option, double tolerance) : m_model([&option](const double& S, const BumpParameters&) { return option.Price(S); }), m_base(), m_tolerance(tolerance), m_levels(8) {}
+
+
+// Parameter constructor with a EuropeanOption
+// Each price sets the parameters on a copy of the option, so the BumpGreeks can be used from several threads
+BumpGreeks::BumpGreeks(const EuropeanOption& option, double tolerance) : m_model(), m_base(), m_tolerance(tolerance), m_levels(8) {
+
+	m_base.T = option.Expiry();
+	m_base.r = option.RiskFreeRate();
+	m_base.b = option.CostOfCarry();
+	m_base.sig = option.Volatility();
+
+	m_model = [option](const double& S, const BumpParameters& p) {
+
+		EuropeanOption bumped(option);
+		bumped.Expiry(p.T);
+		bumped.RiskFreeRate(p.r);
+		bumped.CostOfCarry(p.b);
+		bumped.Volatility(p.sig);
+
+		return bumped.Price(S);
+	};
+}
+
+
+// Parameter constructor with a PerpetualAmericanOption
+BumpGreeks::BumpGreeks(const PerpetualAmericanOption& option, double tolerance) : m_model(), m_base(), m_tolerance(tolerance), m_levels(8) {
+
+	m_base.r = option.RiskFreeRate();
+	m_base.b = option.CostOfCarry();
+	m_base.sig = option.Volatility();
+
+	m_model = [option](const double& S, const BumpParameters& p) {
+
+		PerpetualAmericanOption bumped(option);
+		bumped.RiskFreeRate(p.r);
+		bumped.CostOfCarry(p.b);
+		bumped.Volatility(p.sig);
+
+		return bumped.Price(S);
+	};
+}
+
+
+// Destructor
+BumpGreeks::~BumpGreeks() {}
+
+
+// Copy constructor
+BumpGreeks::BumpGreeks(const BumpGreeks& source) : m_model(source.m_model), m_base(source.m_base), m_tolerance(source.m_tolerance), m_levels(source.m_levels) {}
+
+
+// Assignment operator
+BumpGreeks& BumpGreeks::operator = (const BumpGreeks& source) {
+
+	if (this == &source) {
+		return *this;
+	}
+
+	m_model = source.m_model;
+	m_base = source.m_base;
+	m_tolerance = source.m_tolerance;
+	m_levels = source.m_levels;
+
+	return *this;
+}
+
+
+
+// Returns the derivatives of the price in one parameter
+// The lambda only captures a reference, so it fits in the std::function without a heap allocation
+BumpResult BumpGreeks::Parameter(double BumpParameters::* parameter, const double& S, const double& price, const double& scale) const {
+
+	struct Bump {
+		const BumpGreeks* greeks;
+		double BumpParameters::* parameter;
+		double S;
+	};
+
+	Bump bump = { this, parameter, S };
+
+	std::function<double(const double&)> f = [&bump](const double& x) {
+		BumpParameters p = bump.greeks->m_base;
+		p.*bump.parameter = x;
+		return bump.greeks->m_model(bump.S, p);
+	};
+
+	return Derivatives(f, m_base.*parameter, price, scale, m_tolerance, m_levels);
+}
+
+
+
+// Returns the delta and the gamma at spot price S
+// The count of reprices includes the unbumped price
+BumpResult BumpGreeks::Spot(const double& S) const {
+
+	const BumpGreeks* greeks = this;
+
+	std::function<double(const double&)> f = [greeks](const double& x) { return greeks->m_model(x, greeks->m_base); };
+
+	BumpResult result = Derivatives(f, S, f(S), SPOT_SCALE, m_tolerance, m_levels);
+	++result.reprices;
+
+	return result;
+}
+
+
+// Returns vega and volga at spot price S
+BumpResult BumpGreeks::Volatility(const double& S) const {
+
+	BumpResult result = this->Parameter(&BumpParameters::sig, S, m_model(S, m_base), 0);
+	++result.reprices;
+
+	return result;
+}
+
+
+// Returns rho and the second derivative in r at spot price S
+BumpResult BumpGreeks::Rate(const double& S) const {
+
+	BumpResult result = this->Parameter(&BumpParameters::r, S, m_model(S, m_base), RATE_SCALE);
+	++result.reprices;
+
+	return result;
+}
+
+
+// Returns the first and second derivatives in the cost of carry at spot price S
+BumpResult BumpGreeks::Carry(const double& S) const {
+
+	BumpResult result = this->Parameter(&BumpParameters::b, S, m_model(S, m_base), RATE_SCALE);
+	++result.reprices;
+
+	return result;
+}
+
+
+// Returns theta and the second derivative in T at spot price S
+// The scale of 0 makes every step a fraction of T, so T - h is never 0 or negative
+BumpResult BumpGreeks::Time(const double& S) const {
+
+	BumpResult result = this->Parameter(&BumpParameters::T, S, m_model(S, m_base), 0);
+	// 0 - rather than a minus sign, so that a model without an expiry has a theta of 0 and not -0
+	result.first = 0 - result.first;
+	++result.reprices;
+
+	return result;
+}
+
+
+// Returns the price and the greeks of every parameter with one base price
+// Only the base price is shared, since every parameter needs its own bumped prices
+BumpSensitivities BumpGreeks::All(const double& S) const {
+
+	BumpSensitivities all;
+
+	all.price = m_model(S, m_base);
+
+	const BumpGreeks* greeks = this;
+
+	std::function<double(const double&)> f = [greeks](const double& x) { return greeks->m_model(x, greeks->m_base); };
+
+	all.spot = Derivatives(f, S, all.price, SPOT_SCALE, m_tolerance, m_levels);
+	all.volatility = this->Parameter(&BumpParameters::sig, S, all.price, 0);
+	all.rate = this->Parameter(&BumpParameters::r, S, all.price, RATE_SCALE);
+	all.carry = this->Parameter(&BumpParameters::b, S, all.price, RATE_SCALE);
+	all.time = this->Parameter(&BumpParameters::T, S, all.price, 0);
+	all.time.first = 0 - all.time.first;
+
+	all.reprices = 1 + all.spot.reprices + all.volatility.reprices + all.rate.reprices + all.carry.reprices + all.time.reprices;
+
+	return all;
+}
+
+
+
+// Returns the first and second derivatives of f at x
+// Row i of each table holds the central difference at step h / 2^i and its extrapolations, where column j has cancelled the errors up to h^(2j)
+// Each greek keeps the entry of its table with the smallest estimated error, which is the distance to its neighbours in the table
+// Once a greek has reached the tolerance, or its table has started to diverge, it stops improving, and the steps stop when both greeks have stopped
+BumpResult BumpGreeks::Derivatives(const std::function<double(const double&)>& f, const double& x, const double& base, const double& scale, const double& tolerance, const int& levels) {
+
+	double h = FIRST_STEP * max(abs(x), scale);
+
+	// A parameter and a scale of 0, such as the expiry of a model without one, leave no step, and the model is taken not to depend on the parameter
+	if (h == 0) {
+		BumpResult flat = { 0, 0, 0, 0, 0 };
+		return flat;
+	}
+
+	double first[MAX_LEVELS][MAX_LEVELS], second[MAX_LEVELS][MAX_LEVELS];
+
+	int steps = max(2, min(MAX_LEVELS, levels));
+
+	BumpResult result = { 0, 0, HUGE_VAL, HUGE_VAL, 0 };
+	bool first_done = false, second_done = false;
+
+	for (int i = 0; i < steps; ++i, h *= 0.5) {
+
+		double up = f(x + h);
+		double down = f(x - h);
+		result.reprices += 2;
+
+		first[i][0] = (up - down) / (2 * h);
+		second[i][0] = (up - 2 * base + down) / (h * h);
+
+		if (i == 0) {
+			result.first = first[0][0];
+			result.second = second[0][0];
+			continue;
+		}
+
+		double factor = 1;
+
+		for (int j = 1; j <= i; ++j) {
+
+			factor *= 4;
+
+			first[i][j] = first[i][j - 1] + (first[i][j - 1] - first[i - 1][j - 1]) / (factor - 1);
+			second[i][j] = second[i][j - 1] + (second[i][j - 1] - second[i - 1][j - 1]) / (factor - 1);
+
+			double first_error = max(abs(first[i][j] - first[i][j - 1]), abs(first[i][j] - first[i - 1][j - 1]));
+			double second_error = max(abs(second[i][j] - second[i][j - 1]), abs(second[i][j] - second[i - 1][j - 1]));
+
+			if (!first_done && first_error <= result.first_error) {
+				result.first = first[i][j];
+				result.first_error = first_error;
+			}
+
+			if (!second_done && second_error <= result.second_error) {
+				result.second = second[i][j];
+				result.second_error = second_error;
+			}
+		}
+
+		first_done = first_done || result.first_error <= tolerance * abs(result.first) || abs(first[i][i] - first[i - 1][i - 1]) >= DIVERGENCE * result.first_error;
+		second_done = second_done || result.second_error <= tolerance * abs(result.second) || abs(second[i][i] - second[i - 1][i - 1]) >= DIVERGENCE * result.second_error;
+
+		if (first_done && second_done) break;
+	}
+
+	return result;
+}
@@ -0,0 +1,134 @@
+// Objective: Create the BumpGreeks class that computes greeks of any pricing model by bumping and repricing with Richardson extrapolation
+
+// Ensure no errors if the header file is used twice
+#ifndef BUMPGREEKS_HPP
+#define BUMPGREEKS_HPP
+
+// Include header files
+#include "Option.hpp"
+#include "EuropeanOption.hpp"
+#include "PerpetualAmericanOption.hpp"
+#include <iostream>
+#include <vector>
+#include <functional>
+using namespace std;
+
+
+
+// Create the BumpResult struct
+// The first and second derivatives of a price, the estimates of their errors, and the number of times the price was computed
+struct BumpResult {
+	double first;
+	double second;
+	double first_error;
+	double second_error;
+	int reprices;
+};
+
+
+// Create the BumpParameters struct
+// The parameters of a model other than the spot price that can be bumped
+// T is unused by models without an expiry, such as the PerpetualAmericanOption
+struct BumpParameters {
+	double T;
+	double r;
+	double b;
+	double sig;
+};
+
+
+// Create the BumpSensitivities struct
+// The greeks of every parameter, computed from one base price, and the number of times the price was computed in all
+// time holds theta, the change of the price as time passes, which is minus the derivative in T, and the second derivative in T
+struct BumpSensitivities {
+	double price;
+	BumpResult spot;
+	BumpResult volatility;
+	BumpResult rate;
+	BumpResult carry;
+	BumpResult time;
+	int reprices;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the BumpGreeks class
+// The model is only seen through a function that returns its price at a spot price and a set of BumpParameters, so any Option, or any other engine, can be used
+// A model given only as a price of the spot price, such as an Option, does not depend on the other parameters, so their greeks are 0
+// Both greeks come from the same bumped prices: the central first and second differences at steps h, h / 2, h / 4, ...
+// have errors in even powers of h, so each new step is combined with the previous ones in a Richardson table that cancels one more power of h per column
+// The first step is taken from the scale of the parameter, and the steps are halved until both greeks reach the tolerance,
+// or until the estimated error grows again because the differences are cancelling, in which case the best earlier value is kept
+// The unbumped price is computed once and shared by every step and by both greeks, and All() shares it across the greeks of every parameter
+class BumpGreeks {
+private:
+
+	// The price of the model at a spot price and a set of parameters, and the parameters that are bumped
+	std::function<double(const double&, const BumpParameters&)> m_model;
+	BumpParameters m_base;
+
+	// The relative accuracy to reach and the largest number of steps
+	double m_tolerance;
+	int m_levels;
+
+	// Returns the first and second derivatives of the price in one parameter, given the price at S and the base parameters
+	// The first step is 1% of the larger of the parameter and scale
+	BumpResult Parameter(double BumpParameters::* parameter, const double& S, const double& price, const double& scale) const;
+
+public:
+
+	// Default constructor
+	// A model worth 0 everywhere, with a tolerance of 1e-8 and at most 8 steps
+	BumpGreeks();
+
+	// Parameter constructor with the price of the model, the relative accuracy to reach, and the largest number of steps, between 2 and 16
+	BumpGreeks(const std::function<double(const double&)>& price, double tolerance, int levels);
+
+	// Parameter constructor with the price of the model at a spot price and a set of parameters, the parameters to bump, the relative accuracy to reach,
+	// and the largest number of steps, between 2 and 16
+	BumpGreeks(const std::function<double(const double&, const BumpParameters&)>& model, const BumpParameters& base, double tolerance, int levels);
+
+	// Parameter constructor with an Option, which must outlive the BumpGreeks, and the relative accuracy to reach
+	// Only the spot price of an Option can be bumped
+	BumpGreeks(const Option& option, double tolerance);
+
+	// Parameter constructors with a copy of a EuropeanOption or a PerpetualAmericanOption, whose T, r, b, and sig are bumped, and the relative accuracy to reach
+	BumpGreeks(const EuropeanOption& option, double tolerance);
+	BumpGreeks(const PerpetualAmericanOption& option, double tolerance);
+
+	// Destructor
+	virtual ~BumpGreeks();
+
+	// Copy constructor
+	BumpGreeks(const BumpGreeks& source);
+
+	// Assignment operator
+	BumpGreeks& operator = (const BumpGreeks& source);
+
+	// Returns the delta and the gamma at spot price S
+	BumpResult Spot(const double& S) const;
+
+	// Return the first and second derivatives at spot price S in the volatility (vega and volga), the risk free rate (rho), and the cost of carry
+	// Each bumps one parameter with the others held, so Rate() keeps b and not b - r
+	BumpResult Volatility(const double& S) const;
+	BumpResult Rate(const double& S) const;
+	BumpResult Carry(const double& S) const;
+
+	// Returns theta, minus the derivative in T, and the second derivative in T at spot price S
+	// The first step is 1% of T, so the bumped expiry stays positive
+	BumpResult Time(const double& S) const;
+
+	// Returns the price and the greeks of every parameter at spot price S, with one base price shared by all of them
+	BumpSensitivities All(const double& S) const;
+
+	// Returns the first and second derivatives of f at x, given base = f(x)
+	// The first step is 1% of the larger of |x| and scale, so a parameter that can be 0, such as a rate, still gets a sensible step
+	// When both are 0 there is no step, and the derivatives are 0
+	static BumpResult Derivatives(const std::function<double(const double&)>& f, const double& x, const double& base, const double& scale, const double& tolerance, const int& levels);
+
+};
+
+
+
+#endif
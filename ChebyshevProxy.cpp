@@ -0,0 +1,251 @@
+// Objective: Implement the ChebyshevProxy class
+
+// Include the necessary header files
+#include "ChebyshevProxy.hpp"
+#include "EuropeanOption.hpp"
+#include "Exception.hpp"
+#include <iostream>
+using namespace std;
+#include <cmath>
+#include <vector>
+
+
+
+// The number of scenarios that are evaluated together, so that the Clenshaw recurrence runs across a block of scenarios and can be vectorized
+static const int PROXY_BLOCK = 8;
+
+
+// Pi
+static const double PI = 3.14159265358979323846;
+
+
+
+// Default constructor
+ChebyshevProxy::ChebyshevProxy() : m_option(), m_min(0), m_max(0), m_price(), m_delta(), m_error(0), m_tolerance(0) {}
+
+
+// Parameter constructor
+// The price and delta are sampled at the degree + 1 Chebyshev nodes of [S_min, S_max]
+// The error bound is the largest error on a grid of 4 points per node, including both ends of the range, plus the size of the last 2 coefficients
+// Throws an OutOfBoundsException if the degree is below 1 or if the range is empty, which includes a NaN bound
+ChebyshevProxy::ChebyshevProxy(const EuropeanOption& option, double S_min, double S_max, int degree, double tolerance) : m_option(option), m_min(S_min), m_max(S_max), m_price(), m_delta(), m_error(0), m_tolerance(tolerance) {
+
+	if (degree < 1) throw OutOfBoundsException(degree);
+	if (!(S_max > S_min)) throw OutOfBoundsException(0);
+
+	int N = degree + 1;
+
+	m_price.resize(N);
+	m_delta.resize(N);
+
+	// Sample the price and the delta at the nodes
+	std::vector<double> fp(N), fd(N);
+
+	for (int k = 0; k < N; ++k) {
+
+		double x = cos(PI * (k + 0.5) / N);
+		double S = 0.5 * (m_max + m_min) + 0.5 * (m_max - m_min) * x;
+
+		fp[k] = m_option.Price(S);
+		fd[k] = m_option.Delta(S);
+	}
+
+	// Compute the coefficients
+	for (int j = 0; j < N; ++j) {
+
+		double sp = 0, sd = 0;
+
+		for (int k = 0; k < N; ++k) {
+
+			double w = cos(PI * j * (k + 0.5) / N);
+
+			sp += fp[k] * w;
+			sd += fd[k] * w;
+		}
+
+		m_price[j] = 2.0 * sp / N;
+		m_delta[j] = 2.0 * sd / N;
+	}
+
+	m_price[0] *= 0.5;
+	m_delta[0] *= 0.5;
+
+	// Check the fit on the grid
+	int M = 4 * N;
+
+	for (int i = 0; i <= M; ++i) {
+
+		double S = m_min + (m_max - m_min) * i / M;
+
+		m_error = max(m_error, abs(this->Evaluate(m_price, S) - m_option.Price(S)));
+		m_error = max(m_error, abs(this->Evaluate(m_delta, S) - m_option.Delta(S)));
+	}
+
+	// Add the size of the tail of the series
+	m_error += max(abs(m_price[N - 1]) + abs(m_price[N - 2]), abs(m_delta[N - 1]) + abs(m_delta[N - 2]));
+}
+
+
+// Destructor
+ChebyshevProxy::~ChebyshevProxy() {}
+
+
+// Copy constructor
+ChebyshevProxy::ChebyshevProxy(const ChebyshevProxy& source) : m_option(source.m_option), m_min(source.m_min), m_max(source.m_max), m_price(source.m_price), m_delta(source.m_delta), m_error(source.m_error), m_tolerance(source.m_tolerance) {}
+
+
+// Assignment operator
+ChebyshevProxy& ChebyshevProxy::operator = (const ChebyshevProxy& source) {
+
+	if (this == &source) {
+		return *this;
+	}
+
+	m_option = source.m_option;
+	m_min = source.m_min;
+	m_max = source.m_max;
+	m_price = source.m_price;
+	m_delta = source.m_delta;
+	m_error = source.m_error;
+	m_tolerance = source.m_tolerance;
+
+	return *this;
+}
+
+
+
+// Evaluates a Chebyshev series at a spot price inside the range
+double ChebyshevProxy::Evaluate(const std::vector<double>& c, const double& S) const {
+
+	double x = (2.0 * S - m_max - m_min) / (m_max - m_min);
+
+	double b1 = 0, b2 = 0;
+
+	for (int k = c.size() - 1; k > 0; --k) {
+
+		double tmp = 2.0 * x * b1 - b2 + c[k];
+
+		b2 = b1;
+		b1 = tmp;
+	}
+
+	return x * b1 - b2 + c[0];
+}
+
+
+
+// Evaluates a Chebyshev series at n spot prices
+// The scenarios are evaluated in blocks, and the recurrence steps through the coefficients for the whole block at once
+// Scenarios outside of the range are priced exactly
+void ChebyshevProxy::Evaluate(const std::vector<double>& c, const bool& delta, const double* S, double* out, const int& n) const {
+
+	double scale = 2.0 / (m_max - m_min);
+	double shift = (m_max + m_min) / (m_max - m_min);
+
+	for (int i = 0; i < n; i += PROXY_BLOCK) {
+
+		int m = min(PROXY_BLOCK, n - i);
+
+		double x[PROXY_BLOCK], b1[PROXY_BLOCK], b2[PROXY_BLOCK];
+
+		for (int j = 0; j < PROXY_BLOCK; ++j) {
+			x[j] = j < m ? S[i + j] * scale - shift : 0.0;
+			b1[j] = 0;
+			b2[j] = 0;
+		}
+
+		for (int k = c.size() - 1; k > 0; --k) {
+			for (int j = 0; j < PROXY_BLOCK; ++j) {
+
+				double tmp = 2.0 * x[j] * b1[j] - b2[j] + c[k];
+
+				b2[j] = b1[j];
+				b1[j] = tmp;
+			}
+		}
+
+		for (int j = 0; j < m; ++j) {
+
+			if (S[i + j] < m_min || S[i + j] > m_max) {
+				out[i + j] = delta ? m_option.Delta(S[i + j]) : m_option.Price(S[i + j]);
+			}
+
+			else {
+				out[i + j] = x[j] * b1[j] - b2[j] + c[0];
+			}
+		}
+	}
+}
+
+
+
+// Returns the error bound of the fit
+double ChebyshevProxy::ErrorBound() const {
+	return m_error;
+}
+
+
+// Returns true if the error bound meets the tolerance
+bool ChebyshevProxy::Accurate() const {
+	return m_error <= m_tolerance;
+}
+
+
+
+// Price at one spot price
+// Falls back to exact pricing if the proxy is not accurate or S is outside the range
+double ChebyshevProxy::Price(const double& S) const {
+
+	if (!this->Accurate() || S < m_min || S > m_max) {
+		return m_option.Price(S);
+	}
+
+	return this->Evaluate(m_price, S);
+}
+
+
+// Delta at one spot price
+// Falls back to the exact delta if the proxy is not accurate or S is outside the range
+double ChebyshevProxy::Delta(const double& S) const {
+
+	if (!this->Accurate() || S < m_min || S > m_max) {
+		return m_option.Delta(S);
+	}
+
+	return this->Evaluate(m_delta, S);
+}
+
+
+
+// Prices at n scenario spot prices
+// Falls back to exact pricing for every scenario if the proxy is not accurate
+void ChebyshevProxy::PriceScenarios(const double* S, double* out, const int& n) const {
+
+	if (!this->Accurate()) {
+
+		for (int i = 0; i < n; ++i) {
+			out[i] = m_option.Price(S[i]);
+		}
+
+		return;
+	}
+
+	this->Evaluate(m_price, false, S, out, n);
+}
+
+
+// Deltas at n scenario spot prices
+// Falls back to the exact delta for every scenario if the proxy is not accurate
+void ChebyshevProxy::DeltaScenarios(const double* S, double* out, const int& n) const {
+
+	if (!this->Accurate()) {
+
+		for (int i = 0; i < n; ++i) {
+			out[i] = m_option.Delta(S[i]);
+		}
+
+		return;
+	}
+
+	this->Evaluate(m_delta, true, S, out, n);
+}
@@ -0,0 +1,80 @@
+// Objective: Create the ChebyshevProxy class that approximates the price and delta of a EuropeanOption in the spot price
+
+// Ensure no errors if the header file is used twice
+#ifndef CHEBYSHEVPROXY_HPP
+#define CHEBYSHEVPROXY_HPP
+
+// Include header files
+#include "EuropeanOption.hpp"
+#include <iostream>
+#include <vector>
+using namespace std;
+
+
+
+// Create the ChebyshevProxy class
+// The proxy fits Chebyshev polynomials of the price and of the delta of one position in S over [S_min, S_max]
+// The fit is checked against the exact price and delta when it is built, and the largest error found is kept as the error bound
+// If the error bound is above the tolerance, or a spot price is outside the range, the proxy falls back to exact pricing
+class ChebyshevProxy {
+private:
+
+	// The position that is approximated
+	EuropeanOption m_option;
+
+	// The range of the spot price
+	double m_min;
+	double m_max;
+
+	// The Chebyshev coefficients of the price and of the delta
+	std::vector<double> m_price;
+	std::vector<double> m_delta;
+
+	// The error bound of the fit and the tolerance that it must meet
+	double m_error;
+	double m_tolerance;
+
+	// Evaluates a Chebyshev series at a spot price inside the range with the Clenshaw recurrence
+	double Evaluate(const std::vector<double>& c, const double& S) const;
+
+	// Evaluates a Chebyshev series at n spot prices, falling back to the exact function outside the range
+	void Evaluate(const std::vector<double>& c, const bool& delta, const double* S, double* out, const int& n) const;
+
+public:
+
+	// Default constructor
+	ChebyshevProxy();
+
+	// Parameter constructor
+	// Fits polynomials of the given degree to the option over [S_min, S_max]
+	// Throws an OutOfBoundsException if the degree is below 1 or if S_max is not above S_min
+	ChebyshevProxy(const EuropeanOption& option, double S_min, double S_max, int degree, double tolerance);
+
+	// Destructor
+	virtual ~ChebyshevProxy();
+
+	// Copy constructor
+	ChebyshevProxy(const ChebyshevProxy& source);
+
+	// Assignment operator
+	ChebyshevProxy& operator = (const ChebyshevProxy& source);
+
+	// Returns the error bound of the fit
+	double ErrorBound() const;
+
+	// Returns true if the error bound meets the tolerance, so that the proxy is used instead of exact pricing
+	bool Accurate() const;
+
+	// Price and delta at one spot price
+	double Price(const double& S) const;
+	double Delta(const double& S) const;
+
+	// Prices and deltas at n scenario spot prices
+	void PriceScenarios(const double* S, double* out, const int& n) const;
+	void DeltaScenarios(const double* S, double* out, const int& n) const;
+
+};
+
+
+
+#endif
@@ -0,0 +1,149 @@
+// Objective: Implement the Executor, TaskGroup, and Task classes
+
+// Include the necessary header files
+#include "Coroutines.hpp"
+#include <iostream>
+using namespace std;
+#include <vector>
+#include <algorithm>
+
+
+
+// Parameter constructor
+// Starts at least one thread
+Executor::Executor(int threads) : m_ready(), m_stopping(false), m_threads() {
+
+	for (int i = 0; i < max(1, threads); ++i) {
+		m_threads.push_back(std::thread(&Executor::Work, this));
+	}
+}
+
+
+// Destructor
+Executor::~Executor() {
+	this->Stop();
+}
+
+
+// Posts a coroutine
+void Executor::Post(std::coroutine_handle<> handle) {
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_ready.push_back(handle);
+	}
+
+	m_wake.notify_one();
+}
+
+
+// Stops the threads once every posted coroutine has been resumed
+void Executor::Stop() {
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+
+	m_wake.notify_all();
+
+	for (std::size_t i = 0; i < m_threads.size(); ++i) {
+		m_threads[i].join();
+	}
+
+	m_threads.clear();
+}
+
+
+// Returns the awaitable that moves the awaiting coroutine onto this Executor
+Executor::ScheduleAwaiter Executor::Schedule() {
+	return ScheduleAwaiter{ *this };
+}
+
+
+// The thread loop
+void Executor::Work() {
+
+	while (true) {
+
+		std::coroutine_handle<> handle;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			while (m_ready.empty() && !m_stopping) {
+				m_wake.wait(lock);
+			}
+
+			if (m_ready.empty()) return;
+
+			handle = m_ready.front();
+			m_ready.pop_front();
+		}
+
+		handle.resume();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Default constructor
+TaskGroup::TaskGroup() : m_live(0), m_error() {}
+
+
+// Destructor
+TaskGroup::~TaskGroup() {}
+
+
+// Counts a Task that is started
+void TaskGroup::Started() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	++m_live;
+}
+
+
+// Counts a Task that has finished, keeping the first exception
+void TaskGroup::Finished(std::exception_ptr error) {
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (error && !m_error) {
+		m_error = error;
+	}
+
+	if (--m_live == 0) {
+		m_done.notify_all();
+	}
+}
+
+
+// Waits until every Task has finished
+void TaskGroup::Wait() {
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (m_live > 0) {
+		m_done.wait(lock);
+	}
+
+	if (m_error) {
+		std::exception_ptr error = m_error;
+		m_error = 0;
+		std::rethrow_exception(error);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Starts the Task on an Executor as a member of a TaskGroup
+void Task::Start(Executor& executor, TaskGroup& group) {
+
+	handle.promise().group = &group;
+	group.Started();
+
+	executor.Post(handle);
+}
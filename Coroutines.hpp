@@ -0,0 +1,298 @@
+// Objective: Create the Executor class, the Task coroutine type, and the Channel template that the coroutine pipeline is built from
+
+// Ensure no errors if the header file is used twice
+#ifndef COROUTINES_HPP
+#define COROUTINES_HPP
+
+// Include header files
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <optional>
+#include <exception>
+#include <coroutine>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+using namespace std;
+
+
+
+// Create the Executor class
+// An Executor is a pool of threads that resume coroutines in the order they are posted
+// A coroutine moves onto an Executor with co_await executor.Schedule(), and a Channel resumes a waiting coroutine on the Executor it waited from
+class Executor {
+private:
+
+	// The coroutines waiting for a thread
+	std::deque<std::coroutine_handle<>> m_ready;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	bool m_stopping;
+
+	// The threads
+	std::vector<std::thread> m_threads;
+
+	// The thread loop
+	void Work();
+
+	// Executors own their threads and cannot be copied
+	Executor(const Executor& source);
+	Executor& operator = (const Executor& source);
+
+public:
+
+	// Parameter constructor with the number of threads
+	Executor(int threads);
+
+	// Destructor
+	// Stops the threads once every posted coroutine has been resumed
+	virtual ~Executor();
+
+	// Posts a coroutine to be resumed by one of the threads
+	void Post(std::coroutine_handle<> handle);
+
+	// Stops the threads once every posted coroutine has been resumed
+	void Stop();
+
+	// The awaitable that moves the awaiting coroutine onto this Executor
+	struct ScheduleAwaiter {
+		Executor& executor;
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle) { executor.Post(handle); }
+		void await_resume() const noexcept {}
+	};
+
+	ScheduleAwaiter Schedule();
+
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the TaskGroup class
+// A TaskGroup counts the Tasks that have been started and not finished, and keeps the first exception that one of them threw
+class TaskGroup {
+private:
+
+	int m_live;
+	std::exception_ptr m_error;
+	std::mutex m_mutex;
+	std::condition_variable m_done;
+
+	// TaskGroups are shared by their Tasks and cannot be copied
+	TaskGroup(const TaskGroup& source);
+	TaskGroup& operator = (const TaskGroup& source);
+
+public:
+
+	// Default constructor
+	TaskGroup();
+
+	// Destructor
+	virtual ~TaskGroup();
+
+	// Counts a Task that is started, and one that has finished with or without an exception
+	void Started();
+	void Finished(std::exception_ptr error);
+
+	// Waits until every Task has finished, and throws the first exception again
+	void Wait();
+
+};
+
+
+// Create the Task struct
+// A Task is a coroutine that starts suspended, is started on an Executor by Start(), and destroys itself when it finishes
+struct Task {
+
+	struct promise_type {
+
+		TaskGroup* group = 0;
+		std::exception_ptr error;
+
+		Task get_return_object() { return Task{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { error = std::current_exception(); }
+
+		// Reports to the group and destroys the frame, so nothing of the Task is left once the group sees it finish
+		struct FinalAwaiter {
+			bool await_ready() const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+				TaskGroup* group = handle.promise().group;
+				std::exception_ptr error = handle.promise().error;
+				handle.destroy();
+				group->Finished(error);
+			}
+			void await_resume() const noexcept {}
+		};
+
+		FinalAwaiter final_suspend() noexcept { return {}; }
+	};
+
+	std::coroutine_handle<promise_type> handle;
+
+	// Starts the Task on an Executor as a member of a TaskGroup
+	void Start(Executor& executor, TaskGroup& group);
+
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the Channel class
+// A Channel is a bounded queue between coroutines: co_await Push() suspends while the Channel is full, and co_await Pop() suspends while it is empty
+// A suspended coroutine does not hold a thread, and it is resumed on the Executor it passed to Push() or Pop()
+// Close() ends the Channel: Pop() returns the remaining items and then an empty optional, and Push() returns false
+template <typename T>
+class Channel {
+private:
+
+	// A coroutine waiting in Push() with its item, or in Pop() with the place for its item
+	struct Waiter {
+		std::coroutine_handle<> handle;
+		Executor* executor;
+		T* item;
+		std::optional<T>* slot;
+		bool* pushed;
+	};
+
+	std::deque<T> m_items;
+	std::size_t m_capacity;
+	bool m_closed;
+
+	std::deque<Waiter> m_pushers;
+	std::deque<Waiter> m_poppers;
+	std::mutex m_mutex;
+
+	// Channels are shared by their coroutines and cannot be copied
+	Channel(const Channel& source);
+	Channel& operator = (const Channel& source);
+
+public:
+
+	// Parameter constructor with the number of items the Channel holds before Push() suspends
+	Channel(std::size_t capacity) : m_items(), m_capacity(capacity < 1 ? 1 : capacity), m_closed(false) {}
+
+	// Destructor
+	virtual ~Channel() {}
+
+	// The awaitable of Push()
+	// A waiting popper is handed the item directly, otherwise the item is queued if there is room, otherwise the pusher waits
+	struct PushAwaiter {
+		Channel& channel;
+		Executor& executor;
+		T item;
+		bool pushed = false;
+
+		bool await_ready() const noexcept { return false; }
+
+		bool await_suspend(std::coroutine_handle<> handle) {
+
+			std::unique_lock<std::mutex> lock(channel.m_mutex);
+
+			if (channel.m_closed) return false;
+
+			if (!channel.m_poppers.empty()) {
+
+				Waiter popper = channel.m_poppers.front();
+				channel.m_poppers.pop_front();
+				*popper.slot = std::move(item);
+				pushed = true;
+
+				lock.unlock();
+				popper.executor->Post(popper.handle);
+				return false;
+			}
+
+			if (channel.m_items.size() < channel.m_capacity) {
+				channel.m_items.push_back(std::move(item));
+				pushed = true;
+				return false;
+			}
+
+			Waiter pusher = { handle, &executor, &item, 0, &pushed };
+			channel.m_pushers.push_back(pusher);
+			return true;
+		}
+
+		bool await_resume() const noexcept { return pushed; }
+	};
+
+	// The awaitable of Pop()
+	// Taking an item makes room for the first waiting pusher, whose item is queued in its place
+	struct PopAwaiter {
+		Channel& channel;
+		Executor& executor;
+		std::optional<T> slot;
+
+		bool await_ready() const noexcept { return false; }
+
+		bool await_suspend(std::coroutine_handle<> handle) {
+
+			std::unique_lock<std::mutex> lock(channel.m_mutex);
+
+			if (!channel.m_items.empty()) {
+
+				slot = std::move(channel.m_items.front());
+				channel.m_items.pop_front();
+
+				if (!channel.m_pushers.empty()) {
+
+					Waiter pusher = channel.m_pushers.front();
+					channel.m_pushers.pop_front();
+					channel.m_items.push_back(std::move(*pusher.item));
+					*pusher.pushed = true;
+
+					lock.unlock();
+					pusher.executor->Post(pusher.handle);
+				}
+
+				return false;
+			}
+
+			if (channel.m_closed) return false;
+
+			Waiter popper = { handle, &executor, 0, &slot, 0 };
+			channel.m_poppers.push_back(popper);
+			return true;
+		}
+
+		std::optional<T> await_resume() { return std::move(slot); }
+	};
+
+	// Returns the awaitable that pushes an item, which returns false if the Channel is closed
+	PushAwaiter Push(T item, Executor& executor) {
+		return PushAwaiter{ *this, executor, std::move(item) };
+	}
+
+	// Returns the awaitable that pops an item, which returns an empty optional once the Channel is closed and empty
+	PopAwaiter Pop(Executor& executor) {
+		return PopAwaiter{ *this, executor, std::nullopt };
+	}
+
+	// Closes the Channel and resumes every waiting coroutine
+	void Close() {
+
+		std::deque<Waiter> waiters;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			m_closed = true;
+			waiters.swap(m_poppers);
+			waiters.insert(waiters.end(), m_pushers.begin(), m_pushers.end());
+			m_pushers.clear();
+		}
+
+		for (std::size_t i = 0; i < waiters.size(); ++i) {
+			waiters[i].executor->Post(waiters[i].handle);
+		}
+	}
+
+};
+
+
+
+#endif
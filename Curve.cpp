@@ -0,0 +1,160 @@
+// Objective: Implement the Curve class
+
+// Include the necessary header files
+#include "Curve.hpp"
+#include "Exception.hpp"
+#include <iostream>
+using namespace std;
+#include <cmath>
+#include <vector>
+
+
+
+// Default constructor
+// A Curve starts off with no pillars
+Curve::Curve() : m_expiries(), m_rates(), m_discount(), m_growth() {}
+
+
+// Parameter constructor
+// Throws an OutOfBoundsException if there is not exactly one rate per expiry
+Curve::Curve(std::vector<double> expiries, std::vector<double> rates) : m_expiries(expiries), m_rates(rates), m_discount(expiries.size()), m_growth(expiries.size()) {
+
+	if (rates.size() != expiries.size()) throw OutOfBoundsException(rates.size());
+
+	// Compute the factors of every pillar once
+	for (int i = 0; i < m_expiries.size(); ++i) {
+		this->Cache(i);
+	}
+}
+
+
+// Destructor
+Curve::~Curve() {}
+
+
+// Copy constructor
+Curve::Curve(const Curve& source) : m_expiries(source.m_expiries), m_rates(source.m_rates), m_discount(source.m_discount), m_growth(source.m_growth) {}
+
+
+// Assignment operator
+Curve& Curve::operator = (const Curve& source) {
+
+	if (this == &source) {
+		return *this;
+	}
+
+	m_expiries = source.m_expiries;
+	m_rates = source.m_rates;
+	m_discount = source.m_discount;
+	m_growth = source.m_growth;
+
+	return *this;
+}
+
+
+// Recomputes the cached factors of a pillar
+void Curve::Cache(const int& index) {
+	m_discount[index] = exp(-m_rates[index] * m_expiries[index]);
+	m_growth[index] = exp(m_rates[index] * m_expiries[index]);
+}
+
+
+// Modifier for the rate of a pillar
+// Throws an OutOfBoundsException if the index is out of bounds
+void Curve::Rate(const int& index, const double& rate) {
+
+	if (index < 0 || index >= m_rates.size()) throw OutOfBoundsException(index);
+
+	m_rates[index] = rate;
+
+	this->Cache(index);
+}
+
+
+// Accessors for a pillar
+// Each accessor throws an OutOfBoundsException if the index is out of bounds
+
+double Curve::Expiry(const int& index) const {
+
+	if (index < 0 || index >= m_expiries.size()) throw OutOfBoundsException(index);
+
+	return m_expiries[index];
+}
+
+double Curve::Rate(const int& index) const {
+
+	if (index < 0 || index >= m_rates.size()) throw OutOfBoundsException(index);
+
+	return m_rates[index];
+}
+
+double Curve::Discount(const int& index) const {
+
+	if (index < 0 || index >= m_discount.size()) throw OutOfBoundsException(index);
+
+	return m_discount[index];
+}
+
+double Curve::Growth(const int& index) const {
+
+	if (index < 0 || index >= m_growth.size()) throw OutOfBoundsException(index);
+
+	return m_growth[index];
+}
+
+
+// Returns the number of pillars of the Curve
+int Curve::Pillars() const {
+	return m_expiries.size();
+}
+
+
+// Returns the index of the pillar with expiry T
+// Returns -1 if no pillar has that expiry
+int Curve::Pillar(const double& T) const {
+
+	for (int i = 0; i < m_expiries.size(); ++i) {
+		if (m_expiries[i] == T) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+
+// Returns the rate at T
+// The pillars do not have to be sorted: the nearest pillar below T and the nearest pillar above T are searched for
+double Curve::RateAt(const double& T) const {
+
+	int below = -1, above = -1;
+
+	for (int i = 0; i < m_expiries.size(); ++i) {
+
+		if (m_expiries[i] <= T && (below == -1 || m_expiries[i] > m_expiries[below])) {
+			below = i;
+		}
+
+		if (m_expiries[i] >= T && (above == -1 || m_expiries[i] < m_expiries[above])) {
+			above = i;
+		}
+	}
+
+	if (below == -1 && above == -1) return 0;
+
+	if (below == -1) return m_rates[above];
+
+	if (above == -1 || m_expiries[above] == m_expiries[below]) return m_rates[below];
+
+	double w = (T - m_expiries[below]) / (m_expiries[above] - m_expiries[below]);
+
+	return (1 - w) * m_rates[below] + w * m_rates[above];
+}
+
+
+
+// Returns the forward factor exp((b - r) * T) of a pillar
+// The yield curve and the cost of carry curve must share the same pillars, which the curve constructor of EuropeanOption checks
+double ForwardFactor(const Curve& yield, const Curve& carry, const int& index) {
+	return carry.Growth(index) * yield.Discount(index);
+}
@@ -0,0 +1,86 @@
+// Objective: Create the Curve class that holds a term structure of rates and caches its discount and growth factors
+
+// Ensure no errors if the header file is used twice
+#ifndef CURVE_HPP
+#define CURVE_HPP
+
+// Include header files
+#include <iostream>
+#include <vector>
+using namespace std;
+
+
+
+// Create the Curve class
+// A Curve is used both as a yield curve (r) and as a cost of carry curve (b)
+// Each pillar stores an expiry and a continuously compounded rate, and the exponentials for that pillar are computed once when the rate is set
+// Options that share an expiry can then reference the same pillar instead of recomputing exp(-r * T) and exp((b - r) * T) for every price
+class Curve {
+private:
+
+	// The private attributes are the pillar expiries, the pillar rates, and the cached factors of each pillar
+
+	// Expiry of each pillar
+	std::vector<double> m_expiries;
+
+	// Rate of each pillar
+	std::vector<double> m_rates;
+
+	// Cached exp(-rate * T) of each pillar
+	std::vector<double> m_discount;
+
+	// Cached exp(rate * T) of each pillar
+	std::vector<double> m_growth;
+
+	// Recomputes the cached factors of a pillar
+	void Cache(const int& index);
+
+public:
+
+	// Default constructor
+	Curve();
+
+	// Parameter constructor
+	Curve(std::vector<double> expiries, std::vector<double> rates);
+
+	// Destructor
+	virtual ~Curve();
+
+	// Copy constructor
+	Curve(const Curve& source);
+
+	// Assignment operator
+	Curve& operator = (const Curve& source);
+
+	// Modifier for the rate of a pillar, the cached factors of the pillar are updated as well
+	void Rate(const int& index, const double& rate);
+
+	// Accessors for a pillar
+	double Expiry(const int& index) const;
+	double Rate(const int& index) const;
+
+	// Returns the cached exp(-rate * T) of a pillar
+	double Discount(const int& index) const;
+
+	// Returns the cached exp(rate * T) of a pillar
+	double Growth(const int& index) const;
+
+	// Returns the number of pillars of the Curve
+	int Pillars() const;
+
+	// Returns the index of the pillar with expiry T, or -1 if the Curve has no such pillar
+	int Pillar(const double& T) const;
+
+	// Returns the rate at T, linearly interpolated between the pillars on either side of T and flat beyond the first and last pillars
+	// Returns 0 if the Curve has no pillars
+	double RateAt(const double& T) const;
+
+};
+
+
+// A global function that returns the forward factor exp((b - r) * T) of a pillar from a yield curve and a cost of carry curve without calling exp
+double ForwardFactor(const Curve& yield, const Curve& carry, const int& index);
+
+
+
+#endif
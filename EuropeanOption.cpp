@@ -3,6 +3,9 @@
 // Include the necessary header files
 #include "Option.hpp"
 #include "EuropeanOption.hpp"
+#include "Kernels.hpp"
+#include "Instrumentation.hpp"
+#include "Exception.hpp"
 #include <boost/math/distributions.hpp>
 #include <boost/math/distributions/normal.hpp>
 #include "boost/tuple/tuple.hpp"
@@ -15,11 +18,31 @@ using namespace boost::math;
 
 
 // Default constructor
-EuropeanOption::EuropeanOption() : Option(), K(0), T(0), r(0), b(0), sig(0), q(0) {}
+EuropeanOption::EuropeanOption() : Option(), K(0), T(0), r(0), b(0), sig(0), q(0), yield_curve(), carry_curve(), pillar(-1) {}
 
 
 // Parameter constructor
-EuropeanOption::EuropeanOption(double strike, double expiry, double rate, double carry, double sigma, double div) : Option(), K(strike), T(expiry), r(rate), b(carry), sig(sigma), q(div) {}
+EuropeanOption::EuropeanOption(double strike, double expiry, double rate, double carry, double sigma, double div) : Option(), K(strike), T(expiry), r(rate), b(carry), sig(sigma), q(div), yield_curve(), carry_curve(), pillar(-1) {}
+
+
+// Parameter constructor that references a pillar of a yield curve and a cost of carry curve
+// The option keeps a share of each curve, so the curves stay alive while the option or any copy of it does
+// Throws an OutOfBoundsException if a curve is null, if the pillar is out of bounds of either curve, or if the two curves have different expiries at the pillar,
+// since the forward factor combines the factors of both curves at the same pillar
+EuropeanOption::EuropeanOption(double strike, std::shared_ptr<const Curve> yield, std::shared_ptr<const Curve> carry, int index, double sigma, double div) : Option(), K(strike), T(0), r(0), b(0), sig(sigma), q(div), yield_curve(), carry_curve(), pillar(-1) {
+
+	if (!yield || !carry) throw OutOfBoundsException(index);
+
+	T = yield->Expiry(index);
+	r = yield->Rate(index);
+	b = carry->Rate(index);
+
+	if (carry->Expiry(index) != T) throw OutOfBoundsException(index);
+
+	yield_curve = yield;
+	carry_curve = carry;
+	pillar = index;
+}
 
 
 // Destructor
@@ -27,7 +50,7 @@ EuropeanOption::~EuropeanOption() {}
 
 
 // Copy constructor
-EuropeanOption::EuropeanOption(const EuropeanOption& source) : Option(), K(source.K), T(source.T), r(source.r), b(source.b), sig(source.sig), q(source.q) {}
+EuropeanOption::EuropeanOption(const EuropeanOption& source) : Option(source), K(source.K), T(source.T), r(source.r), b(source.b), sig(source.sig), q(source.q), yield_curve(source.yield_curve), carry_curve(source.carry_curve), pillar(source.pillar) {}
 
 
 // Assignment operator
@@ -45,6 +68,9 @@ EuropeanOption& EuropeanOption::operator = (const EuropeanOption& source) {
 	b = source.b;
 	sig = source.sig;
 	q = source.q;
+	yield_curve = source.yield_curve;
+	carry_curve = source.carry_curve;
+	pillar = source.pillar;
 
 	return *this;
 }
@@ -57,14 +83,23 @@ void EuropeanOption::StrikePrice(const double& newK) {
 
 void EuropeanOption::Expiry(const double& newT) {
 	T = newT;
+	yield_curve.reset();
+	carry_curve.reset();
+	pillar = -1;
 }
 
 void EuropeanOption::RiskFreeRate(const double& newr) {
 	r = newr;
+	yield_curve.reset();
+	carry_curve.reset();
+	pillar = -1;
 }
 
 void EuropeanOption::CostOfCarry(const double& newb) {
 	b = newb;
+	yield_curve.reset();
+	carry_curve.reset();
+	pillar = -1;
 }
 
 void EuropeanOption::Volatility(const double& newsig) {
@@ -86,11 +121,22 @@ double EuropeanOption::Expiry() const {
 	return T;
 }
 
+// The rates of an option that references its curves are read from the curves, so that a change of a pillar's rate is seen by every price and greek
 double EuropeanOption::RiskFreeRate() const {
+
+	if (yield_curve) {
+		return yield_curve->Rate(pillar);
+	}
+
 	return r;
 }
 
 double EuropeanOption::CostOfCarry() const {
+
+	if (carry_curve) {
+		return carry_curve->Rate(pillar);
+	}
+
 	return b;
 }
 
@@ -102,6 +148,36 @@ double EuropeanOption::Dividend() const {
 	return q;
 }
 
+int EuropeanOption::Pillar() const {
+	return pillar;
+}
+
+
+
+// Returns exp(-r * T)
+// Uses the cached factor of the yield curve's pillar if the option references one
+double EuropeanOption::DiscountFactor() const {
+
+	if (yield_curve) {
+		return yield_curve->Discount(pillar);
+	}
+
+	return exp(-r * T);
+}
+
+
+
+// Returns exp((b - r) * T)
+// Uses the cached factors of the curves' pillar if the option references them
+double EuropeanOption::CarryFactor() const {
+
+	if (yield_curve && carry_curve) {
+		return ForwardFactor(*yield_curve, *carry_curve, pillar);
+	}
+
+	return exp((b - r) * T);
+}
+
 
 
 // Accessor for all the private attributes
@@ -109,7 +185,7 @@ std::string EuropeanOption::Description() const {
 
 	std::stringstream ss;
 
-	ss << " " << K << " " << T << " " << r << " " << b << " " << sig << " " << q << " " << Option::OptionType() << endl;
+	ss << " " << K << " " << T << " " << this->RiskFreeRate() << " " << this->CostOfCarry() << " " << sig << " " << q << " " << Option::OptionType() << endl;
 
 	return ss.str();
 }
@@ -117,22 +193,18 @@ std::string EuropeanOption::Description() const {
 
 
 // Prices the EuropeanOption
+// Uses the double precision kernels
 double EuropeanOption::Price(const double& S) const {
 
-	// Initialize a standard Gaussian RV
-	normal_distribution<> nd(0.0, 1.0);
-
-	// Compute d1 and d2
-	double d1 = (log(S / K) + (r + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	double d2 = d1 - (sig * sqrt(T));
+	PROBE(PROBE_PRICE);
 
 	// If the option type is a call, compute for a call
 	if (Option::OptionType() == "Call") {
-		return S * cdf(nd, d1) * exp((b - r) * T) - K * exp(-r * T) * cdf(nd, d2);
+		return EuropeanCall<double>(S, K, T, this->CostOfCarry(), sig, this->DiscountFactor(), this->CarryFactor());
 	}
 
 	// Otherwise, the option type is a put and compute for a put
-	return K * cdf(nd, -d2) * exp(-r * T) - S * cdf(nd, -d1) * exp((b - r) * T);
+	return EuropeanPut<double>(S, K, T, this->CostOfCarry(), sig, this->DiscountFactor(), this->CarryFactor());
 }
 
 
@@ -140,21 +212,13 @@ double EuropeanOption::Price(const double& S) const {
 // Prices the opposite option type for a EuropeanOption using the Put-Call Parity (PCP)
 double EuropeanOption::PCP_Price(const double& S) const {
 
-	// Initialize a standard Gaussian RV
-	normal_distribution<> nd(0.0, 1.0);
-
-	// Compute d1 and d2
-	double d1 = (log(S / K) + (r + (sig * sig) * 0.5) * T) / (sig * sqrt(T));
-	double d2 = d1 - (sig * sqrt(T));
-
 	// If the option type is a call, compute for a put
 	if (Option::OptionType() == "Call") {
-
-		return K * cdf(nd, -d2) * exp(-r * T) - S * cdf(nd, -d1) * exp((b - r) * T);
+		return EuropeanPut<double>(S, K, T, this->CostOfCarry(), sig, this->DiscountFactor(), this->CarryFactor());
 	}
 
 	// Otherwise, the option type is a put and compute for a call
-	return S * cdf(nd, d1) * exp((b - r) * T) - K * exp(-r * T) * cdf(nd, d2);
+	return EuropeanCall<double>(S, K, T, this->CostOfCarry(), sig, this->DiscountFactor(), this->CarryFactor());
 }
 
 
@@ -167,13 +231,13 @@ std::string EuropeanOption::InternalConfirmPCP(const double& S) const {
 
 	// Check if the difference is less than the tolerance and the current option type is a call
 	// Return a string of confirmation if so
-	if (abs((this->Price(S) + K * exp(-r * T)) - (this->PCP_Price(S) + S * exp((b - r) * T))) < tol && Option::OptionType() == "Call") {
+	if (abs((this->Price(S) + K * this->DiscountFactor()) - (this->PCP_Price(S) + S * this->CarryFactor())) < tol && Option::OptionType() == "Call") {
 		return "The current option is a Call and the Put-Call Parity is preserved.";
 	}
 
 	// Check if the difference is less than the tolerance and the current option type is a put
 	// Return a string of confirmation if so
-	else if (abs((this->PCP_Price(S) + K * exp(-r * T)) - (this->Price(S) + S * exp((b - r) * T))) < tol && Option::OptionType() == "Put") {
+	else if (abs((this->PCP_Price(S) + K * this->DiscountFactor()) - (this->Price(S) + S * this->CarryFactor())) < tol && Option::OptionType() == "Put") {
 		return "The current option is a Put and the Put-Call Parity is preserved.";
 	}
 
@@ -191,13 +255,13 @@ std::string EuropeanOption::ConfirmPCP(const EuropeanOption& other, const double
 
 	// Check if the difference is less than the tolerance and the current option type is a call
 	// Return a string of confirmation if so
-	if (abs((this->Price(S) + K * exp(-r * T)) - (other.Price(S) + S * exp((b - r) * T))) < tol && Option::OptionType() == "Call") {
+	if (abs((this->Price(S) + K * this->DiscountFactor()) - (other.Price(S) + S * this->CarryFactor())) < tol && Option::OptionType() == "Call") {
 		return "The current option is a Call and the Put-Call Parity is preserved.";
 	}
 
 	// Check if the difference is less than the tolerance and the current option type is a put
 	// Return a string of confirmation if so
-	else if (abs((other.Price(S) + K * exp(-r * T)) - (this->Price(S) + S * exp((b - r) * T))) < tol && Option::OptionType() == "Put") {
+	else if (abs((other.Price(S) + K * this->DiscountFactor()) - (this->Price(S) + S * this->CarryFactor())) < tol && Option::OptionType() == "Put") {
 		return "The current option is a Put and the Put-Call Parity is preserved.";
 	}
 
@@ -278,37 +342,28 @@ boost::tuple<vector<double>, vector<double>, vector<double>> EuropeanOption::Spo
 // The Delta method
 double EuropeanOption::Delta(const double& S) const {
 
-	// Initialize a standard Gaussian RV
-	normal_distribution<> nd(0.0, 1.0);
-
-	// Compute d1
-	double tmp = sig * sqrt(T);
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / tmp;
-
-
-	// If the option type is a call, compute the delta for a call
-	if (Option::OptionType() == "Call") {
-		return exp((b - r) * T) * cdf(nd, d1);
-	}
+	PROBE(PROBE_DELTA);
 
-	// Otherwise, the option type is a put and compute delta for a put
-	return exp((b - r) * T) * (cdf(nd, d1) - 1.0);
+	return EuropeanDelta<double>(Option::OptionType() == "Call", S, K, T, this->CostOfCarry(), sig, this->CarryFactor());
 }
 
 
 
 // The Gamma method
+// Since gamma is the same for calls and puts, no need to separate between the option types
 double EuropeanOption::Gamma(const double& S) const {
 
-	// Initialize a standard Gaussian RV
-	normal_distribution<> nd(0.0, 1.0);
+	PROBE(PROBE_GAMMA);
+
+	return EuropeanGamma<double>(S, K, T, this->CostOfCarry(), sig, this->CarryFactor());
+}
+
 
-	// Compute d1
-	double tmp = sig * sqrt(T);
-	double d1 = (log(S / K) + (b + (sig * sig) * 0.5) * T) / tmp;
 
-	// Since gamma is the same for calls and puts, no need to separate between the option types
-	return (pdf(nd, d1) * exp((b - r) * T)) / (S * sig * sqrt(T));
+// The HigherGreeks method
+// Only charm depends on the option type
+HigherOrderGreeks<double> EuropeanOption::HigherGreeks(const double& S) const {
+	return EuropeanHigherGreeks<double>(Option::OptionType() == "Call", S, K, T, this->RiskFreeRate(), this->CostOfCarry(), sig, this->CarryFactor());
 }
 
 
@@ -6,8 +6,11 @@
 
 // Include header files
 #include "Option.hpp"
+#include "Curve.hpp"
+#include "Kernels.hpp"
 #include <iostream>
 #include <vector>
+#include <memory>
 using namespace std;
 #include <boost/math/distributions/normal.hpp>
 #include "boost/tuple/tuple.hpp"
@@ -39,6 +42,18 @@ private:
 	// Dividend rate
 	double q;
 
+	// The yield curve, the cost of carry curve, and the pillar the option references
+	// The curves are shared with the caller and with every copy of the option, so they live as long as any of them, and are null when the option uses its flat r and b
+	std::shared_ptr<const Curve> yield_curve;
+	std::shared_ptr<const Curve> carry_curve;
+	int pillar;
+
+	// Returns exp(-r * T), looked up from the yield curve when the option references one
+	double DiscountFactor() const;
+
+	// Returns exp((b - r) * T), looked up from the curves when the option references them
+	double CarryFactor() const;
+
 public:
 
 	// Default constructor
@@ -47,6 +62,11 @@ public:
 	// Parameter constructor
 	EuropeanOption(double K, double T, double r, double b, double sig, double q);
 
+	// Parameter constructor that references a pillar of a yield curve and a cost of carry curve
+	// T is taken from the pillar, and r and b are read from the curves every time they are used, so changes of the curves' rates are seen by the option
+	// Throws an OutOfBoundsException if a curve is null or the curves do not both have the pillar with the same expiry
+	EuropeanOption(double K, std::shared_ptr<const Curve> yield, std::shared_ptr<const Curve> carry, int pillar, double sig, double q);
+
 	// Destructor
 	virtual ~EuropeanOption();
 
@@ -57,6 +77,7 @@ public:
 	EuropeanOption& operator = (const EuropeanOption& source);
 
 	// Modifiers for the private attributes
+	// Changing T, r, or b stops the option from referencing its curves
 	void StrikePrice(const double& K);
 	void Expiry(const double& T);
 	void RiskFreeRate(const double& r);
@@ -65,6 +86,7 @@ public:
 	void Dividend(const double& q);
 
 	// Accessors for the private attributes
+	// RiskFreeRate and CostOfCarry return the rates of the pillar when the option references its curves
 	double StrikePrice() const;
 	double Expiry() const;
 	double RiskFreeRate() const;
@@ -72,6 +94,9 @@ public:
 	double Volatility() const;
 	double Dividend() const;
 
+	// Accessor for the referenced pillar, -1 if the option does not reference a curve
+	int Pillar() const;
+
 	// Accessor for all private attributes
 	std::string Description() const;
 
@@ -100,6 +125,9 @@ public:
 	// The Gamma method
 	double Gamma(const double& S) const;
 
+	// Computes vanna, volga, charm, speed, zomma, and color in one evaluation
+	HigherOrderGreeks<double> HigherGreeks(const double& S) const;
+
 	// Computes the approximation of delta
 	double Delta(const double& S, const double& h) const;
 
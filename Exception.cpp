@@ -18,3 +18,59 @@ std::string OutOfBoundsException::GetMessage() const {
 	s << "OH NO! Bound error!" << endl;
 	return s.str();
 }
+
+
+
+// The SerializationException constructor with an argument
+// Set m_reason as the reason for the error
+SerializationException::SerializationException(const std::string& reason) : ArrayException(), m_reason(reason) {}
+
+
+// Override the GetMessage() method with the reason for the error
+std::string SerializationException::GetMessage() const {
+	std::stringstream s;
+	s << "Serialization error: " << m_reason << endl;
+	return s.str();
+}
+
+
+
+// The SocketException constructor with an argument
+// Set m_reason as the reason for the error
+SocketException::SocketException(const std::string& reason) : ArrayException(), m_reason(reason) {}
+
+
+// Override the GetMessage() method with the reason for the error
+std::string SocketException::GetMessage() const {
+	std::stringstream s;
+	s << "Socket error: " << m_reason << endl;
+	return s.str();
+}
+
+
+
+// The SharedMemoryException constructor with an argument
+// Set m_reason as the reason for the error
+SharedMemoryException::SharedMemoryException(const std::string& reason) : ArrayException(), m_reason(reason) {}
+
+
+// Override the GetMessage() method with the reason for the error
+std::string SharedMemoryException::GetMessage() const {
+	std::stringstream s;
+	s << "Shared memory error: " << m_reason << endl;
+	return s.str();
+}
+
+
+
+// The OutputException constructor with an argument
+// Set m_reason as the reason for the error
+OutputException::OutputException(const std::string& reason) : ArrayException(), m_reason(reason) {}
+
+
+// Override the GetMessage() method with the reason for the error
+std::string OutputException::GetMessage() const {
+	std::stringstream s;
+	s << "Output error: " << m_reason << endl;
+	return s.str();
+}
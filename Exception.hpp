@@ -39,6 +39,94 @@ public:
 
 };
 
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Create the SerializationException class as an inheritance of ArrayException
+// Thrown when a binary file or snapshot cannot be opened, or its contents do not match the expected format
+class SerializationException : public ArrayException {
+private:
+
+	// The private attribute is the reason for the error
+	std::string m_reason;
+
+public:
+
+	// A constructor that creates a SerializationException object with the reason as its argument
+	SerializationException(const std::string&);
+
+	// Override ArrayException's GetMessage() method
+	std::string GetMessage() const;
+
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Create the SocketException class as an inheritance of ArrayException
+// Thrown when the pricing server or one of its clients cannot open, bind, or connect a socket
+class SocketException : public ArrayException {
+private:
+
+	// The private attribute is the reason for the error
+	std::string m_reason;
+
+public:
+
+	// A constructor that creates a SocketException object with the reason as its argument
+	SocketException(const std::string&);
+
+	// Override ArrayException's GetMessage() method
+	std::string GetMessage() const;
+
+};
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Create the SharedMemoryException class as an inheritance of ArrayException
+// Thrown when the shared memory of a SharedRing cannot be created, opened, or mapped
+class SharedMemoryException : public ArrayException {
+private:
+
+	// The private attribute is the reason for the error
+	std::string m_reason;
+
+public:
+
+	// A constructor that creates a SharedMemoryException object with the reason as its argument
+	SharedMemoryException(const std::string&);
+
+	// Override ArrayException's GetMessage() method
+	std::string GetMessage() const;
+
+};
+
+
+// Create the OutputException class as an inheritance of ArrayException
+// Thrown when a ResultEmitter cannot open or write its output
+class OutputException : public ArrayException {
+private:
+
+	// The private attribute is the reason for the error
+	std::string m_reason;
+
+public:
+
+	// A constructor that creates an OutputException object with the reason as its argument
+	OutputException(const std::string&);
+
+	// Override ArrayException's GetMessage() method
+	std::string GetMessage() const;
+
+};
+
 #endif
 
 
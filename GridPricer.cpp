@@ -0,0 +1,241 @@
+// Objective: Implement the GridPricer class
+
+// Include the necessary header files
+#include "GridPricer.hpp"
+#include "EuropeanOption.hpp"
+#include "Exception.hpp"
+#include "Kernels.hpp"
+#include <iostream>
+using namespace std;
+#include <cmath>
+#include <vector>
+#include <thread>
+#include "Scheduler.hpp"
+#include <algorithm>
+
+
+
+// Default constructor
+GridPricer::GridPricer() : m_option(), m_S(0), m_row_index(0), m_rows(), m_col_index(5), m_cols(), m_threads(1), m_calls(), m_puts(), m_delta_calls(), m_delta_puts(), m_gammas(), m_col_terms(), m_col_df(), m_col_cf() {}
+
+
+// Parameter constructor
+// threads: the number of threads, or 0 for one per hardware thread
+GridPricer::GridPricer(EuropeanOption EO, double S, int row_index, std::vector<double> rows, int col_index, std::vector<double> cols, int threads) : m_option(EO), m_S(S), m_row_index(row_index), m_rows(rows), m_col_index(col_index), m_cols(cols), m_threads(threads), m_calls(), m_puts(), m_delta_calls(), m_delta_puts(), m_gammas(), m_col_terms(), m_col_df(), m_col_cf() {
+
+	if (row_index < 0 || row_index > 5) throw OutOfBoundsException(row_index);
+
+	if (col_index < 0 || col_index > 5 || col_index == row_index) throw OutOfBoundsException(col_index);
+
+	if (m_threads <= 0) {
+		m_threads = max(1, int(std::thread::hardware_concurrency()));
+	}
+}
+
+
+// Destructor
+GridPricer::~GridPricer() {}
+
+
+// Copy constructor
+GridPricer::GridPricer(const GridPricer& source) : m_option(source.m_option), m_S(source.m_S), m_row_index(source.m_row_index), m_rows(source.m_rows), m_col_index(source.m_col_index), m_cols(source.m_cols), m_threads(source.m_threads),
+	m_calls(source.m_calls), m_puts(source.m_puts), m_delta_calls(source.m_delta_calls), m_delta_puts(source.m_delta_puts), m_gammas(source.m_gammas), m_col_terms(source.m_col_terms), m_col_df(source.m_col_df), m_col_cf(source.m_col_cf) {}
+
+
+// Assignment operator
+GridPricer& GridPricer::operator = (const GridPricer& source) {
+
+	if (this == &source) {
+		return *this;
+	}
+
+	m_option = source.m_option;
+	m_S = source.m_S;
+	m_row_index = source.m_row_index;
+	m_rows = source.m_rows;
+	m_col_index = source.m_col_index;
+	m_cols = source.m_cols;
+	m_threads = source.m_threads;
+	m_calls = source.m_calls;
+	m_puts = source.m_puts;
+	m_delta_calls = source.m_delta_calls;
+	m_delta_puts = source.m_delta_puts;
+	m_gammas = source.m_gammas;
+	m_col_terms = source.m_col_terms;
+	m_col_df = source.m_col_df;
+	m_col_cf = source.m_col_cf;
+
+	return *this;
+}
+
+
+
+// Computes the rows in [first, last)
+// For every cell the parameters are the base ones with the row and column parameters replaced
+// log(S), log(K), and sqrt(T) are computed once per row, taken from m_col_terms along the columns, and computed once otherwise
+// exp(-r * T) and exp((b - r) * T) are computed once if neither axis is r, b, or T, once per row if only the row axis is, taken from m_col_df and m_col_cf if only the column axis is, and once per cell if both are
+void GridPricer::ComputeRows(const int& first, const int& last) {
+
+	int nc = m_cols.size();
+
+	double base[6] = { m_S, m_option.StrikePrice(), m_option.Expiry(), m_option.RiskFreeRate(), m_option.CostOfCarry(), m_option.Volatility() };
+
+	// Transform of each parameter that is shared along an axis: log for S and K, sqrt for T, and the value itself otherwise
+	double base_terms[6] = { log(base[0]), log(base[1]), sqrt(base[2]), base[3], base[4], base[5] };
+
+	bool row_factors = m_row_index >= 2 && m_row_index <= 4;
+	bool col_factors = m_col_index >= 2 && m_col_index <= 4;
+	double df = exp(-base[3] * base[2]);
+	double cf = exp((base[4] - base[3]) * base[2]);
+
+	for (int i = first; i < last; ++i) {
+
+		double p[6], terms[6];
+
+		for (int k = 0; k < 6; ++k) {
+			p[k] = base[k];
+			terms[k] = base_terms[k];
+		}
+
+		// The row term is computed once for the whole row
+		p[m_row_index] = m_rows[i];
+		terms[m_row_index] = m_row_index == 0 || m_row_index == 1 ? log(m_rows[i]) : m_row_index == 2 ? sqrt(m_rows[i]) : m_rows[i];
+
+		// The factors are computed once for the whole row if only the row axis changes them
+		if (row_factors && !col_factors) {
+			df = exp(-p[3] * p[2]);
+			cf = exp((p[4] - p[3]) * p[2]);
+		}
+
+		for (int j = 0; j < nc; ++j) {
+
+			p[m_col_index] = m_cols[j];
+			terms[m_col_index] = m_col_terms[j];
+
+			double S = p[0], T = p[2], r = p[3], b = p[4], sig = p[5];
+			double logSK = terms[0] - terms[1];
+			double tmp = sig * terms[2];
+
+			if (row_factors && col_factors) {
+				df = exp(-r * T);
+				cf = exp((b - r) * T);
+			}
+			else if (col_factors) {
+				df = m_col_df[j];
+				cf = m_col_cf[j];
+			}
+
+			// d1 and d2 of the generalized model, shared by the prices and the greeks as in the EuropeanOption class
+			double d1 = (logSK + (b + (sig * sig) * 0.5) * T) / tmp;
+			double d2 = d1 - tmp;
+
+			int cell = i * nc + j;
+
+			m_calls[cell] = S * NormalCDF(d1) * cf - p[1] * df * NormalCDF(d2);
+			m_puts[cell] = p[1] * NormalCDF(-d2) * df - S * NormalCDF(-d1) * cf;
+			m_delta_calls[cell] = cf * NormalCDF(d1);
+			m_delta_puts[cell] = m_delta_calls[cell] - cf;
+			m_gammas[cell] = NormalPDF(d1) * cf / (S * tmp);
+		}
+	}
+}
+
+
+
+// Computes every surface
+// The rows are handed to the Scheduler as one loop of at most m_threads tasks, or computed on the calling thread when the pricer has one thread
+void GridPricer::Compute() {
+
+	int nr = m_rows.size();
+	int nc = m_cols.size();
+	int cells = nr * nc;
+
+	m_calls.assign(cells, 0.0);
+	m_puts.assign(cells, 0.0);
+	m_delta_calls.assign(cells, 0.0);
+	m_delta_puts.assign(cells, 0.0);
+	m_gammas.assign(cells, 0.0);
+
+	m_col_terms.resize(nc);
+
+	for (int j = 0; j < nc; ++j) {
+		m_col_terms[j] = m_col_index == 0 || m_col_index == 1 ? log(m_cols[j]) : m_col_index == 2 ? sqrt(m_cols[j]) : m_cols[j];
+	}
+
+	// The discount and carry factors of each column, needed only if the column axis is r, b, or T and the row axis is not
+	bool row_factors = m_row_index >= 2 && m_row_index <= 4;
+	bool col_factors = m_col_index >= 2 && m_col_index <= 4;
+
+	if (col_factors && !row_factors) {
+
+		m_col_df.resize(nc);
+		m_col_cf.resize(nc);
+
+		for (int j = 0; j < nc; ++j) {
+
+			double p[3] = { m_option.Expiry(), m_option.RiskFreeRate(), m_option.CostOfCarry() };
+			p[m_col_index - 2] = m_cols[j];
+
+			m_col_df[j] = exp(-p[1] * p[0]);
+			m_col_cf[j] = exp((p[2] - p[1]) * p[0]);
+		}
+	}
+
+	if (m_threads == 1) {
+		this->ComputeRows(0, nr);
+		return;
+	}
+
+	Scheduler::Global().ParallelFor(0, nr, 0, [this](int first, int last) { this->ComputeRows(first, last); }, m_threads);
+}
+
+
+
+// Accessors for the surfaces
+
+const std::vector<double>& GridPricer::Calls() const {
+	return m_calls;
+}
+
+const std::vector<double>& GridPricer::Puts() const {
+	return m_puts;
+}
+
+const std::vector<double>& GridPricer::DeltaCalls() const {
+	return m_delta_calls;
+}
+
+const std::vector<double>& GridPricer::DeltaPuts() const {
+	return m_delta_puts;
+}
+
+const std::vector<double>& GridPricer::Gammas() const {
+	return m_gammas;
+}
+
+
+
+// Outputs a surface with the row values down the side and the column values across the top
+void GridPricer::OutputGrid(const std::vector<double>& surface) const {
+
+	std::cout << '\t';
+
+	for (int j = 0; j < m_cols.size(); ++j) {
+		std::cout << m_cols[j] << '\t';
+	}
+
+	std::cout << endl;
+
+	for (int i = 0; i < m_rows.size(); ++i) {
+
+		std::cout << m_rows[i] << '\t';
+
+		for (int j = 0; j < m_cols.size(); ++j) {
+			std::cout << surface[i * m_cols.size() + j] << '\t';
+		}
+
+		std::cout << endl;
+	}
+
+	std::cout << endl;
+}
@@ -0,0 +1,98 @@
+// Objective: Create the GridPricer class that computes price and greeks surfaces of a EuropeanOption over two parameters in one pass
+
+// Ensure no errors if the header file is used twice
+#ifndef GRIDPRICER_HPP
+#define GRIDPRICER_HPP
+
+// Include header files
+#include "EuropeanOption.hpp"
+#include <iostream>
+#include <vector>
+using namespace std;
+
+
+
+// Create the GridPricer class
+// The two axes are parameter indices with the same numbering as the Vector class:
+// 0: S (Spot price)
+// 1: K (Strike price)
+// 2: T (Expiry)
+// 3: r (Risk free rate)
+// 4: b (Cost of carry rate)
+// 5: sig (Volatility)
+// Terms that only depend on one axis, such as log(S) along a spot axis or sqrt(T) along an expiry axis, are computed once per row or column
+// The discount and carry factors are computed per row or per column along the axis that changes them, and per cell only if both axes do
+// The surfaces are stored row by row, with rows.size() x cols.size() entries
+class GridPricer {
+private:
+
+	// The base option and spot price that the axes vary
+	EuropeanOption m_option;
+	double m_S;
+
+	// The parameter index and the values of each axis
+	int m_row_index;
+	std::vector<double> m_rows;
+	int m_col_index;
+	std::vector<double> m_cols;
+
+	// The number of threads used to compute the surfaces
+	// The loop over the rows is split into at most this many tasks of the Scheduler, so no more threads than this, and than the Scheduler has workers, run it
+	int m_threads;
+
+	// The surfaces
+	std::vector<double> m_calls;
+	std::vector<double> m_puts;
+	std::vector<double> m_delta_calls;
+	std::vector<double> m_delta_puts;
+	std::vector<double> m_gammas;
+
+	// The column terms shared by every row, log or sqrt of the column values, or the values themselves
+	// They are computed once per Compute() into a buffer that is reused, so that the rows do not allocate
+	std::vector<double> m_col_terms;
+
+	// The discount factor exp(-r * T) and carry factor exp((b - r) * T) of each column, used only if the column axis is r, b, or T and the row axis is not
+	// They are computed once per Compute() into buffers that are reused, like the column terms
+	std::vector<double> m_col_df;
+	std::vector<double> m_col_cf;
+
+	// Computes the rows in [first, last)
+	void ComputeRows(const int& first, const int& last);
+
+public:
+
+	// Default constructor
+	GridPricer();
+
+	// Parameter constructor
+	// threads is the number of threads, 0 or less for one per hardware thread, and with 1 thread the surfaces are computed on the calling thread
+	// Throws an OutOfBoundsException if an index is not between 0 and 5 or both axes are the same parameter
+	GridPricer(EuropeanOption EO, double S, int row_index, std::vector<double> rows, int col_index, std::vector<double> cols, int threads);
+
+	// Destructor
+	virtual ~GridPricer();
+
+	// Copy constructor
+	GridPricer(const GridPricer& source);
+
+	// Assignment operator
+	GridPricer& operator = (const GridPricer& source);
+
+	// Computes every surface
+	void Compute();
+
+	// Accessors for the surfaces
+	const std::vector<double>& Calls() const;
+	const std::vector<double>& Puts() const;
+	const std::vector<double>& DeltaCalls() const;
+	const std::vector<double>& DeltaPuts() const;
+	const std::vector<double>& Gammas() const;
+
+	// Outputs a surface with the row values down the side and the column values across the top
+	void OutputGrid(const std::vector<double>& surface) const;
+
+};
+
+
+
+#endif
@@ -0,0 +1,271 @@
+// Objective: Implement the Instrumentation class
+
+// Include the necessary header files
+#include "Instrumentation.hpp"
+#include <iostream>
+using namespace std;
+#include <sstream>
+#include <vector>
+#include <mutex>
+#include <chrono>
+
+
+
+// The names of the entry points, in the order of ProbeId
+static const char* probe_names[PROBE_COUNT] = { "Price", "Delta", "Gamma", "Matrix", "MatrixPricer", "Output", "Calibration" };
+
+
+// The counters of every thread that has recorded a call
+// The counters are never freed, so the calls of threads that have exited are still merged
+static std::vector<ProbeCounters*> registry;
+static std::mutex registry_mutex;
+
+
+// The counters of the calling thread
+static thread_local ProbeCounters* local_counters = 0;
+
+
+
+// Registers a new set of counters for the calling thread
+ProbeCounters* Instrumentation::Register() {
+
+	ProbeCounters* counters = new ProbeCounters();
+
+	for (int i = 0; i < PROBE_COUNT; ++i) {
+
+		counters->calls[i].store(0, std::memory_order_relaxed);
+		counters->ticks[i].store(0, std::memory_order_relaxed);
+
+		for (int j = 0; j < PROBE_BUCKETS; ++j) {
+			counters->histogram[i][j].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	registry.push_back(counters);
+
+	return counters;
+}
+
+
+
+// Returns the counters of the calling thread
+ProbeCounters& Instrumentation::Local() {
+
+	if (local_counters == 0) {
+		local_counters = Register();
+	}
+
+	return *local_counters;
+}
+
+
+
+// Records one call of an entry point
+// Only the calling thread writes to its counters, so a relaxed load and store is enough and no locked instruction is needed
+void Instrumentation::Record(const int& id, const unsigned long long& ticks) {
+
+	ProbeCounters& counters = Local();
+
+	// Find the bucket from the position of the highest set bit of ticks
+#if defined(__GNUC__)
+	int bucket = ticks > 1 ? 63 - __builtin_clzll(ticks) : 0;
+#else
+	int bucket = 0;
+	unsigned long long t = ticks;
+
+	while (t > 1) {
+		t >>= 1;
+		++bucket;
+	}
+#endif
+
+	if (bucket > PROBE_BUCKETS - 1) {
+		bucket = PROBE_BUCKETS - 1;
+	}
+
+	counters.calls[id].store(counters.calls[id].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	counters.ticks[id].store(counters.ticks[id].load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+	counters.histogram[id][bucket].store(counters.histogram[id][bucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+
+
+// Sets every counter of every thread back to 0
+// Calls that are recorded by other threads while resetting may be lost
+void Instrumentation::Reset() {
+
+	std::lock_guard<std::mutex> lock(registry_mutex);
+
+	for (int k = 0; k < registry.size(); ++k) {
+		for (int i = 0; i < PROBE_COUNT; ++i) {
+
+			registry[k]->calls[i].store(0, std::memory_order_relaxed);
+			registry[k]->ticks[i].store(0, std::memory_order_relaxed);
+
+			for (int j = 0; j < PROBE_BUCKETS; ++j) {
+				registry[k]->histogram[i][j].store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
+
+
+// Returns the number of calls of an entry point merged across all threads
+unsigned long long Instrumentation::Calls(const int& id) {
+
+	std::lock_guard<std::mutex> lock(registry_mutex);
+
+	unsigned long long total = 0;
+
+	for (int k = 0; k < registry.size(); ++k) {
+		total += registry[k]->calls[id].load(std::memory_order_relaxed);
+	}
+
+	return total;
+}
+
+
+
+// Returns the number of nanoseconds per tick
+// The time stamp counter is calibrated once against the steady clock over 10 ms
+// The calibration runs in the initializer of a function-local static, so concurrent first calls wait for one calibration
+double Instrumentation::NanosecondsPerTick() {
+
+	static const double ns_per_tick = []() {
+
+		std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		unsigned long long c0 = ReadTSC();
+
+		while (std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(10)) {}
+
+		std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+		unsigned long long c1 = ReadTSC();
+
+		return std::chrono::duration<double, std::nano>(t1 - t0).count() / double(c1 - c0);
+	}();
+
+	return ns_per_tick;
+}
+
+
+
+// Measures the average cost of one probe in nanoseconds by timing n empty probes
+// The calls are recorded under PROBE_CALIBRATION, which is reset afterwards
+double Instrumentation::ProbeOverhead(const int& n) {
+
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < n; ++i) {
+		Probe probe(PROBE_CALIBRATION);
+	}
+
+	std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+	// Clear the calibration calls of the calling thread
+	ProbeCounters& counters = Local();
+	counters.calls[PROBE_CALIBRATION].store(0, std::memory_order_relaxed);
+	counters.ticks[PROBE_CALIBRATION].store(0, std::memory_order_relaxed);
+
+	for (int j = 0; j < PROBE_BUCKETS; ++j) {
+		counters.histogram[PROBE_CALIBRATION][j].store(0, std::memory_order_relaxed);
+	}
+
+	return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+
+
+// Returns the merged counters and histograms as text
+// Each entry point outputs its number of calls, its mean latency, and the non-empty buckets of its histogram
+std::string Instrumentation::Text() {
+
+	double ns = NanosecondsPerTick();
+
+	std::stringstream ss;
+
+	std::lock_guard<std::mutex> lock(registry_mutex);
+
+	for (int i = 0; i < PROBE_COUNT; ++i) {
+
+		// Merge the counters of every thread
+		unsigned long long calls = 0, ticks = 0, histogram[PROBE_BUCKETS] = {};
+
+		for (int k = 0; k < registry.size(); ++k) {
+
+			calls += registry[k]->calls[i].load(std::memory_order_relaxed);
+			ticks += registry[k]->ticks[i].load(std::memory_order_relaxed);
+
+			for (int j = 0; j < PROBE_BUCKETS; ++j) {
+				histogram[j] += registry[k]->histogram[i][j].load(std::memory_order_relaxed);
+			}
+		}
+
+		if (calls == 0) {
+			continue;
+		}
+
+		ss << probe_names[i] << ": " << calls << " calls, mean " << ticks * ns / calls << " ns" << endl;
+
+		for (int j = 0; j < PROBE_BUCKETS; ++j) {
+			if (histogram[j] != 0) {
+				ss << '\t' << "< " << double(2ULL << j) * ns << " ns: " << histogram[j] << endl;
+			}
+		}
+	}
+
+	return ss.str();
+}
+
+
+
+// Returns the merged counters and histograms as JSON
+// Every bucket is output so that the histograms of different runs line up
+std::string Instrumentation::Json() {
+
+	double ns = NanosecondsPerTick();
+
+	std::stringstream ss;
+
+	std::lock_guard<std::mutex> lock(registry_mutex);
+
+	ss << "{\"ns_per_tick\": " << ns << ", \"probes\": [";
+
+	for (int i = 0; i < PROBE_COUNT; ++i) {
+
+		// Merge the counters of every thread
+		unsigned long long calls = 0, ticks = 0, histogram[PROBE_BUCKETS] = {};
+
+		for (int k = 0; k < registry.size(); ++k) {
+
+			calls += registry[k]->calls[i].load(std::memory_order_relaxed);
+			ticks += registry[k]->ticks[i].load(std::memory_order_relaxed);
+
+			for (int j = 0; j < PROBE_BUCKETS; ++j) {
+				histogram[j] += registry[k]->histogram[i][j].load(std::memory_order_relaxed);
+			}
+		}
+
+		if (i > 0) {
+			ss << ", ";
+		}
+
+		ss << "{\"name\": \"" << probe_names[i] << "\", \"calls\": " << calls << ", \"ticks\": " << ticks << ", \"histogram\": [";
+
+		for (int j = 0; j < PROBE_BUCKETS; ++j) {
+
+			if (j > 0) {
+				ss << ", ";
+			}
+
+			ss << histogram[j];
+		}
+
+		ss << "]}";
+	}
+
+	ss << "]}";
+
+	return ss.str();
+}
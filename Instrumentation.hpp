@@ -0,0 +1,142 @@
+// Objective: Create the Instrumentation class and the Probe class that record call counts and latency histograms of the hot paths
+
+// Ensure no errors if the header file is used twice
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+// Include header files
+#include <iostream>
+#include <string>
+#include <atomic>
+using namespace std;
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+
+
+// Instrumentation is toggled at compile time by defining INSTRUMENTATION
+// Without it the PROBE macro expands to nothing, so the hot paths are compiled exactly as if there were no probes
+#ifdef INSTRUMENTATION
+#define PROBE(id) Probe probe(id)
+#else
+#define PROBE(id)
+#endif
+
+
+
+// The entry points that can be probed
+// If it is necessary to probe another entry point, add it before PROBE_COUNT and add its name in Instrumentation.cpp
+enum ProbeId {
+	PROBE_PRICE,
+	PROBE_DELTA,
+	PROBE_GAMMA,
+	PROBE_MATRIX,
+	PROBE_MATRIX_PRICER,
+	PROBE_OUTPUT,
+	PROBE_CALIBRATION,
+	PROBE_COUNT
+};
+
+
+// The number of buckets of a latency histogram
+// Bucket i counts the calls that took between 2^i and 2^(i+1) - 1 ticks
+const int PROBE_BUCKETS = 40;
+
+
+
+// Reads the time stamp counter, or a nanosecond clock on machines without one
+inline unsigned long long ReadTSC() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+
+
+// Create the ProbeCounters struct
+// Each thread owns one ProbeCounters and is the only thread that writes to it
+// The counters are atomics so that another thread can read them while merging, but they are only ever loaded and stored with relaxed ordering
+struct ProbeCounters {
+	std::atomic<unsigned long long> calls[PROBE_COUNT];
+	std::atomic<unsigned long long> ticks[PROBE_COUNT];
+	std::atomic<unsigned long long> histogram[PROBE_COUNT][PROBE_BUCKETS];
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the Instrumentation class
+// The class only has static methods since there is a single set of counters per process
+class Instrumentation {
+private:
+
+	// Returns the counters of the calling thread, registering them on the first call from that thread
+	static ProbeCounters& Local();
+
+	// Registers a new set of counters for the calling thread
+	static ProbeCounters* Register();
+
+public:
+
+	// Records one call of an entry point that took the given number of ticks
+	static void Record(const int& id, const unsigned long long& ticks);
+
+	// Sets every counter of every thread back to 0
+	static void Reset();
+
+	// Returns the number of calls of an entry point merged across all threads
+	static unsigned long long Calls(const int& id);
+
+	// Returns the number of nanoseconds per tick of ReadTSC
+	static double NanosecondsPerTick();
+
+	// Measures the average cost of one probe in nanoseconds
+	static double ProbeOverhead(const int& n);
+
+	// Returns the merged counters and histograms as text
+	static std::string Text();
+
+	// Returns the merged counters and histograms as JSON
+	static std::string Json();
+
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the Probe class
+// A Probe reads the time stamp counter when it is created and records the elapsed ticks when it goes out of scope
+class Probe {
+private:
+
+	// The entry point and the time stamp at the start of the call
+	int m_id;
+	unsigned long long m_start;
+
+	// Probes are only used as scoped objects
+	Probe(const Probe& source);
+	Probe& operator = (const Probe& source);
+
+public:
+
+	// Parameter constructor
+	Probe(const int& id) : m_id(id), m_start(ReadTSC()) {}
+
+	// Destructor
+	~Probe() {
+		Instrumentation::Record(m_id, ReadTSC() - m_start);
+	}
+
+};
+
+
+
+#endif
@@ -0,0 +1,181 @@
+// Objective: Implement the batch entry points of the kernels and the precision report
+
+// Include the necessary header files
+#include "Kernels.hpp"
+#include <iostream>
+using namespace std;
+#include <cmath>
+#include <vector>
+#include <random>
+
+
+
+// Double precision batch entry points
+
+void PriceBatch(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* call, double* put) {
+	EuropeanPriceBatch<double>(n, S, K, T, r, b, sig, call, put);
+}
+
+void GreeksBatch(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* delta_call, double* delta_put, double* gamma) {
+	EuropeanGreeksBatch<double>(n, S, K, T, r, b, sig, delta_call, delta_put, gamma);
+}
+
+
+// Single precision batch entry points
+
+void PriceBatch(const int& n, const float* S, const float* K, const float* T, const float* r, const float* b, const float* sig, float* call, float* put) {
+	EuropeanPriceBatch<float>(n, S, K, T, r, b, sig, call, put);
+}
+
+void GreeksBatch(const int& n, const float* S, const float* K, const float* T, const float* r, const float* b, const float* sig, float* delta_call, float* delta_put, float* gamma) {
+	EuropeanGreeksBatch<float>(n, S, K, T, r, b, sig, delta_call, delta_put, gamma);
+}
+
+
+// Sweep batch entry point
+// The switch is taken once per sweep, and each case is a kernel compiled for its own swept parameter
+
+void SweepBatch(const int& n, const int& index, const double* base, const double* values, double* call, double* put) {
+
+	switch (index) {
+	case 0: EuropeanSweepBatch<0, double>(n, base, values, call, put); break;
+	case 1: EuropeanSweepBatch<1, double>(n, base, values, call, put); break;
+	case 2: EuropeanSweepBatch<2, double>(n, base, values, call, put); break;
+	case 3: EuropeanSweepBatch<3, double>(n, base, values, call, put); break;
+	case 4: EuropeanSweepBatch<4, double>(n, base, values, call, put); break;
+	case 5: EuropeanSweepBatch<5, double>(n, base, values, call, put); break;
+	case 6: EuropeanSweepBatch<6, double>(n, base, values, call, put); break;
+	default: break;
+	}
+}
+
+// Higher order greeks batch entry points
+
+void HigherGreeksBatch(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* vanna, double* volga, double* charm_call, double* charm_put, double* speed, double* zomma, double* color) {
+	EuropeanHigherGreeksBatch<double>(n, S, K, T, r, b, sig, vanna, volga, charm_call, charm_put, speed, zomma, color);
+}
+
+void HigherGreeksBatch(const int& n, const float* S, const float* K, const float* T, const float* r, const float* b, const float* sig, float* vanna, float* volga, float* charm_call, float* charm_put, float* speed, float* zomma, float* color) {
+	EuropeanHigherGreeksBatch<float>(n, S, K, T, r, b, sig, vanna, volga, charm_call, charm_put, speed, zomma, color);
+}
+
+// Mixed precision batch entry points
+
+void PriceBatchMixed(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* call, double* put) {
+	EuropeanPriceBatch<float, double>(n, S, K, T, r, b, sig, call, put);
+}
+
+void GreeksBatchMixed(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* delta_call, double* delta_put, double* gamma) {
+	EuropeanGreeksBatch<float, double>(n, S, K, T, r, b, sig, delta_call, delta_put, gamma);
+}
+
+
+
+// Digital and barrier batch entry points
+
+void DigitalBatch(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, const double* cash, double* cash_call, double* cash_put, double* asset_call, double* asset_put) {
+	DigitalPriceBatch<double>(n, S, K, T, r, b, sig, cash, cash_call, cash_put, asset_call, asset_put);
+}
+
+void DigitalBatch(const int& n, const float* S, const float* K, const float* T, const float* r, const float* b, const float* sig, const float* cash, float* cash_call, float* cash_put, float* asset_call, float* asset_put) {
+	DigitalPriceBatch<float>(n, S, K, T, r, b, sig, cash, cash_call, cash_put, asset_call, asset_put);
+}
+
+void BarrierBatch(const int& n, const BarrierType& type, const bool& call, const double* S, const double* K, const double* H, const double* R, const double* T, const double* r, const double* b, const double* sig, double* out) {
+	BarrierPriceBatch<double>(n, type, call, S, K, H, R, T, r, b, sig, out);
+}
+
+void BarrierBatch(const int& n, const BarrierType& type, const bool& call, const float* S, const float* K, const float* H, const float* R, const float* T, const float* r, const float* b, const float* sig, float* out) {
+	BarrierPriceBatch<float>(n, type, call, S, K, H, R, T, r, b, sig, out);
+}
+
+
+// Outputs the largest absolute error and the largest relative error of a vector of values against the double precision values
+// Relative errors are only taken where the double precision value is not too small to give a meaningful ratio
+static void ReportErrors(const std::string& name, const std::vector<double>& exact, const std::vector<double>& single, const std::vector<double>& mixed) {
+
+	double abs_single = 0, rel_single = 0, abs_mixed = 0, rel_mixed = 0;
+
+	for (int i = 0; i < exact.size(); ++i) {
+
+		double e1 = abs(single[i] - exact[i]);
+		double e2 = abs(mixed[i] - exact[i]);
+
+		abs_single = max(abs_single, e1);
+		abs_mixed = max(abs_mixed, e2);
+
+		if (abs(exact[i]) > 1e-6) {
+			rel_single = max(rel_single, e1 / abs(exact[i]));
+			rel_mixed = max(rel_mixed, e2 / abs(exact[i]));
+		}
+	}
+
+	std::cout << name << '\t' << abs_single << '\t' << rel_single << '\t' << abs_mixed << '\t' << rel_mixed << endl;
+}
+
+
+
+// Prices the options of the arrays in double, single, and mixed precision and outputs the errors of each output
+static void CompareBatch(const std::vector<double>& S, const std::vector<double>& K, const std::vector<double>& T, const std::vector<double>& r, const std::vector<double>& b, const std::vector<double>& sig) {
+
+	int n = S.size();
+
+	// Copy the parameters into single precision arrays
+	std::vector<float> fS(S.begin(), S.end()), fK(K.begin(), K.end()), fT(T.begin(), T.end()), fr(r.begin(), r.end()), fb(b.begin(), b.end()), fsig(sig.begin(), sig.end());
+
+	// Initialize the output arrays of each precision
+	std::vector<double> call(n), put(n), dc(n), dp(n), gamma(n);
+	std::vector<float> fcall(n), fput(n), fdc(n), fdp(n), fgamma(n);
+	std::vector<double> mcall(n), mput(n), mdc(n), mdp(n), mgamma(n);
+
+	PriceBatch(n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &call[0], &put[0]);
+	GreeksBatch(n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &dc[0], &dp[0], &gamma[0]);
+
+	PriceBatch(n, &fS[0], &fK[0], &fT[0], &fr[0], &fb[0], &fsig[0], &fcall[0], &fput[0]);
+	GreeksBatch(n, &fS[0], &fK[0], &fT[0], &fr[0], &fb[0], &fsig[0], &fdc[0], &fdp[0], &fgamma[0]);
+
+	PriceBatchMixed(n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &mcall[0], &mput[0]);
+	GreeksBatchMixed(n, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &mdc[0], &mdp[0], &mgamma[0]);
+
+	std::cout << "Output:" << '\t' << '\t' << "Float abs:" << '\t' << "Float rel:" << '\t' << "Mixed abs:" << '\t' << "Mixed rel:" << endl;
+
+	ReportErrors("Call prices:", call, std::vector<double>(fcall.begin(), fcall.end()), mcall);
+	ReportErrors("Put prices:", put, std::vector<double>(fput.begin(), fput.end()), mput);
+	ReportErrors("Call deltas:", dc, std::vector<double>(fdc.begin(), fdc.end()), mdc);
+	ReportErrors("Put deltas:", dp, std::vector<double>(fdp.begin(), fdp.end()), mdp);
+	ReportErrors("Gammas:\t", gamma, std::vector<double>(fgamma.begin(), fgamma.end()), mgamma);
+}
+
+
+
+// Outputs the accuracy of the single and mixed precision kernels against double precision
+void PrecisionReport(const int& n) {
+
+	// The 4 reference batches of the main function
+	std::cout << "Reference batches: " << endl;
+
+	CompareBatch({ 60, 100, 5, 100 }, { 65, 100, 10, 100 }, { 0.25, 1, 1, 30 }, { 0.08, 0, 0.12, 0.08 }, { 0.08, 0, 0.12, 0.08 }, { 0.3, 0.2, 0.5, 0.3 });
+
+	std::cout << endl;
+
+	// n random options with a fixed seed so that the report can be reproduced
+	std::cout << n << " random options: " << endl;
+
+	std::mt19937 gen(12345);
+	std::uniform_real_distribution<double> spot(50, 150), strike(50, 150), expiry(0.05, 5), rate(0, 0.1), carry(-0.05, 0.1), vol(0.05, 0.8);
+
+	std::vector<double> S(n), K(n), T(n), r(n), b(n), sig(n);
+
+	for (int i = 0; i < n; ++i) {
+		S[i] = spot(gen);
+		K[i] = strike(gen);
+		T[i] = expiry(gen);
+		r[i] = rate(gen);
+		b[i] = carry(gen);
+		sig[i] = vol(gen);
+	}
+
+	CompareBatch(S, K, T, r, b, sig);
+
+	std::cout << endl;
+}
@@ -0,0 +1,575 @@
+// Objective: Create the pricing and greeks kernels of the option classes as templates over the floating-point type
+
+// Ensure no errors if the header file is used twice
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+// Include header files
+#include <iostream>
+#include <vector>
+using namespace std;
+#include <cmath>
+
+
+
+// The kernels are templates with two floating-point types:
+// Calc is the type used for d1, d2, the logarithm, and the normal CDF/PDF
+// Acc is the type of the inputs, the outputs, and the final products and sums
+// Kernel<double> is full double precision, Kernel<float> is full single precision, and Kernel<float, double> is the mixed precision mode
+// The formulas are the same as the ones used by the EuropeanOption and PerpetualAmericanOption classes
+
+
+
+// Standard normal CDF
+template <typename Calc>
+Calc NormalCDF(const Calc& x) {
+	return Calc(0.5) * std::erfc(-x * Calc(0.70710678118654752440));
+}
+
+
+// Standard normal PDF
+template <typename Calc>
+Calc NormalPDF(const Calc& x) {
+	return Calc(0.39894228040143267794) * std::exp(Calc(-0.5) * x * x);
+}
+
+
+// d1 of the generalized Black-Scholes model with cost of carry b
+// d2 is d1 - sig * sqrt(T)
+template <typename Calc, typename Acc = Calc>
+Calc GeneralizedD1(const Acc& S, const Acc& K, const Acc& T, const Acc& b, const Acc& sig) {
+
+	Calc tmp = Calc(sig) * std::sqrt(Calc(T));
+	return (std::log(Calc(S) / Calc(K)) + (Calc(b) + (Calc(sig) * Calc(sig)) * Calc(0.5)) * Calc(T)) / tmp;
+}
+
+
+// Call price given the discount factor df = exp(-r * T) and the carry factor cf = exp((b - r) * T)
+// d1 is the one of the generalized model, with the cost of carry b, so the price is consistent with EuropeanDelta and EuropeanGamma
+template <typename Calc, typename Acc = Calc>
+Acc EuropeanCall(const Acc& S, const Acc& K, const Acc& T, const Acc& b, const Acc& sig, const Acc& df, const Acc& cf) {
+
+	Calc d1 = GeneralizedD1<Calc, Acc>(S, K, T, b, sig);
+	Calc d2 = d1 - Calc(sig) * std::sqrt(Calc(T));
+
+	return S * Acc(NormalCDF(d1)) * cf - K * df * Acc(NormalCDF(d2));
+}
+
+
+// Put price given the discount factor df = exp(-r * T) and the carry factor cf = exp((b - r) * T)
+template <typename Calc, typename Acc = Calc>
+Acc EuropeanPut(const Acc& S, const Acc& K, const Acc& T, const Acc& b, const Acc& sig, const Acc& df, const Acc& cf) {
+
+	Calc d1 = GeneralizedD1<Calc, Acc>(S, K, T, b, sig);
+	Calc d2 = d1 - Calc(sig) * std::sqrt(Calc(T));
+
+	return K * Acc(NormalCDF(-d2)) * df - S * Acc(NormalCDF(-d1)) * cf;
+}
+
+
+// Delta of a call or a put given the carry factor cf = exp((b - r) * T)
+template <typename Calc, typename Acc = Calc>
+Acc EuropeanDelta(const bool& call, const Acc& S, const Acc& K, const Acc& T, const Acc& b, const Acc& sig, const Acc& cf) {
+
+	Calc d1 = GeneralizedD1<Calc, Acc>(S, K, T, b, sig);
+
+	if (call) {
+		return cf * Acc(NormalCDF(d1));
+	}
+
+	return cf * (Acc(NormalCDF(d1)) - Acc(1));
+}
+
+
+// Gamma, which is the same for calls and puts, given the carry factor cf = exp((b - r) * T)
+template <typename Calc, typename Acc = Calc>
+Acc EuropeanGamma(const Acc& S, const Acc& K, const Acc& T, const Acc& b, const Acc& sig, const Acc& cf) {
+
+	Calc tmp = Calc(sig) * std::sqrt(Calc(T));
+	Calc d1 = GeneralizedD1<Calc, Acc>(S, K, T, b, sig);
+
+	return (Acc(NormalPDF(d1)) * cf) / (S * Acc(tmp));
+}
+
+
+// The second and third order greeks of a European option
+// charm and color are the changes of delta and gamma as one unit of time passes, so they are -d/dT
+template <typename Acc>
+struct HigherOrderGreeks {
+	Acc vanna;
+	Acc volga;
+	Acc charm;
+	Acc speed;
+	Acc zomma;
+	Acc color;
+};
+
+
+// Vanna, volga, charm, speed, zomma, and color of a call or a put given the carry factor cf = exp((b - r) * T)
+// Every greek is a product of gamma or vega with d1, d2, and sig * sqrt(T), so d1, d2, and N'(d1) are computed once
+// Only charm differs between calls and puts, by cf * (b - r)
+template <typename Calc, typename Acc = Calc>
+HigherOrderGreeks<Acc> EuropeanHigherGreeks(const bool& call, const Acc& S, const Acc& K, const Acc& T, const Acc& r, const Acc& b, const Acc& sig, const Acc& cf) {
+
+	Calc tmp = Calc(sig) * std::sqrt(Calc(T));
+	Calc d1 = GeneralizedD1<Calc, Acc>(S, K, T, b, sig);
+	Calc d2 = d1 - tmp;
+	Calc pdf = NormalPDF(d1) * Calc(cf);
+
+	Calc gamma = pdf / (Calc(S) * tmp);
+	Calc vega = Calc(S) * pdf * std::sqrt(Calc(T));
+
+	Calc charm = -pdf * (Calc(b) / tmp - d2 / (Calc(2) * Calc(T))) - Calc(cf) * (Calc(b) - Calc(r)) * NormalCDF(d1);
+
+	if (!call) {
+		charm += Calc(cf) * (Calc(b) - Calc(r));
+	}
+
+	HigherOrderGreeks<Acc> greeks;
+
+	greeks.vanna = Acc(-pdf * d2 / Calc(sig));
+	greeks.volga = Acc(vega * d1 * d2 / Calc(sig));
+	greeks.charm = Acc(charm);
+	greeks.speed = Acc(-gamma / Calc(S) * (Calc(1) + d1 / tmp));
+	greeks.zomma = Acc(gamma * (d1 * d2 - Calc(1)) / Calc(sig));
+	greeks.color = Acc(gamma * (Calc(r) - Calc(b) + Calc(b) * d1 / tmp + (Calc(1) - d1 * d2) / (Calc(2) * Calc(T))));
+
+	return greeks;
+}
+
+
+// The exponent y1 of a perpetual American call, or y2 of a put, the roots of 0.5 * sig^2 * y * (y - 1) + b * y - r = 0
+template <typename Calc, typename Acc = Calc>
+Calc PerpetualExponent(const bool& call, const Acc& r, const Acc& b, const Acc& sig) {
+
+	Calc sig2 = Calc(sig) * Calc(sig);
+	Calc fac = Calc(b) / sig2 - Calc(0.5);
+	fac *= fac;
+
+	Calc root = std::sqrt(fac + Calc(2.0) * Calc(r) / sig2);
+
+	return Calc(0.5) - Calc(b) / sig2 + (call ? root : -root);
+}
+
+
+// Perpetual American price given the exponent y of its side
+// The price is V = K / |y - 1| * ((y - 1) / y * S / K)^y
+template <typename Calc, typename Acc = Calc>
+Acc PerpetualPrice(const bool& call, const Acc& S, const Acc& K, const Calc& y) {
+
+	if (call ? Calc(1.0) == y : Calc(0.0) == y)
+		return S;
+
+	Calc fac2 = ((y - Calc(1.0)) * Calc(S)) / (y * Calc(K));
+	return K * Acc(std::pow(fac2, y) / (call ? y - Calc(1.0) : Calc(1.0) - y));
+}
+
+
+// Perpetual American call price
+template <typename Calc, typename Acc = Calc>
+Acc PerpetualCall(const Acc& S, const Acc& K, const Acc& r, const Acc& b, const Acc& sig) {
+	return PerpetualPrice<Calc, Acc>(true, S, K, PerpetualExponent<Calc, Acc>(true, r, b, sig));
+}
+
+
+// Perpetual American put price
+template <typename Calc, typename Acc = Calc>
+Acc PerpetualPut(const Acc& S, const Acc& K, const Acc& r, const Acc& b, const Acc& sig) {
+	return PerpetualPrice<Calc, Acc>(false, S, K, PerpetualExponent<Calc, Acc>(false, r, b, sig));
+}
+
+
+// Perpetual American delta and gamma
+// The exponent and the price are computed once, and delta = y * V / S and gamma = y * (y - 1) * V / S^2
+// Like the prices, they only hold in the continuation region, below the exercise boundary S* = y1 / (y1 - 1) * K of a call and above S* = y2 / (y2 - 1) * K of a put,
+// since past S* the option is exercised and is worth its intrinsic value
+template <typename Calc, typename Acc = Calc>
+void PerpetualGreeks(const bool& call, const Acc& S, const Acc& K, const Acc& r, const Acc& b, const Acc& sig, Acc& delta, Acc& gamma) {
+
+	Calc y = PerpetualExponent<Calc, Acc>(call, r, b, sig);
+	Acc price = PerpetualPrice<Calc, Acc>(call, S, K, y);
+
+	delta = Acc(y) * price / S;
+	gamma = Acc(y) * (Acc(y) - Acc(1.0)) * price / (S * S);
+}
+
+template <typename Calc, typename Acc = Calc>
+Acc PerpetualDelta(const bool& call, const Acc& S, const Acc& K, const Acc& r, const Acc& b, const Acc& sig) {
+
+	Acc delta, gamma;
+	PerpetualGreeks<Calc, Acc>(call, S, K, r, b, sig, delta, gamma);
+
+	return delta;
+}
+
+template <typename Calc, typename Acc = Calc>
+Acc PerpetualGamma(const bool& call, const Acc& S, const Acc& K, const Acc& r, const Acc& b, const Acc& sig) {
+
+	Acc delta, gamma;
+	PerpetualGreeks<Calc, Acc>(call, S, K, r, b, sig, delta, gamma);
+
+	return gamma;
+}
+
+
+// Cash-or-nothing call or put, which pays cash at expiry if the option ends in the money, given the discount factor df = exp(-r * T)
+template <typename Calc, typename Acc = Calc>
+Acc CashOrNothing(const bool& call, const Acc& S, const Acc& K, const Acc& T, const Acc& b, const Acc& sig, const Acc& cash, const Acc& df) {
+
+	Calc d2 = GeneralizedD1<Calc, Acc>(S, K, T, b, sig) - Calc(sig) * std::sqrt(Calc(T));
+
+	return cash * df * Acc(NormalCDF(call ? d2 : -d2));
+}
+
+
+// Asset-or-nothing call or put, which pays the asset at expiry if the option ends in the money, given the carry factor cf = exp((b - r) * T)
+template <typename Calc, typename Acc = Calc>
+Acc AssetOrNothing(const bool& call, const Acc& S, const Acc& K, const Acc& T, const Acc& b, const Acc& sig, const Acc& cf) {
+
+	Calc d1 = GeneralizedD1<Calc, Acc>(S, K, T, b, sig);
+
+	return S * cf * Acc(NormalCDF(call ? d1 : -d1));
+}
+
+
+
+// The single barriers
+// An in option becomes a vanilla option when the barrier is hit, and an out option is cancelled when the barrier is hit
+enum BarrierType {
+	BARRIER_DOWN_IN,
+	BARRIER_UP_IN,
+	BARRIER_DOWN_OUT,
+	BARRIER_UP_OUT
+};
+
+
+// Reiner-Rubinstein price of a single barrier call or put with barrier H and rebate R, given the discount factor df = exp(-r * T) and the carry factor cf = exp((b - r) * T)
+// The rebate of an in option is paid at expiry if the barrier was never hit, and the rebate of an out option is paid when the barrier is hit
+// The price is a sum of the terms A to F of Haug, The Complete Guide to Option Pricing Formulas, chosen by the type, the side, and whether K is above H
+// When the spot is already past the barrier, an in option is worth the vanilla option A and an out option is worth its rebate
+template <typename Calc, typename Acc = Calc>
+Acc Barrier(const BarrierType& type, const bool& call, const Acc& S, const Acc& K, const Acc& H, const Acc& R, const Acc& T, const Acc& r, const Acc& b, const Acc& sig, const Acc& df, const Acc& cf) {
+
+	bool down = type == BARRIER_DOWN_IN || type == BARRIER_DOWN_OUT;
+	bool in = type == BARRIER_DOWN_IN || type == BARRIER_UP_IN;
+
+	Calc phi = call ? Calc(1) : Calc(-1);
+	Calc eta = down ? Calc(1) : Calc(-1);
+
+	Calc sig2 = Calc(sig) * Calc(sig);
+	Calc vol = Calc(sig) * std::sqrt(Calc(T));
+	Calc mu = (Calc(b) - sig2 * Calc(0.5)) / sig2;
+	Calc lambda = std::sqrt(mu * mu + Calc(2) * Calc(r) / sig2);
+
+	Calc shift = (Calc(1) + mu) * vol;
+	Calc x1 = std::log(Calc(S) / Calc(K)) / vol + shift;
+	Calc x2 = std::log(Calc(S) / Calc(H)) / vol + shift;
+	Calc y1 = std::log(Calc(H) * Calc(H) / (Calc(S) * Calc(K))) / vol + shift;
+	Calc y2 = std::log(Calc(H) / Calc(S)) / vol + shift;
+	Calc z = std::log(Calc(H) / Calc(S)) / vol + lambda * vol;
+
+	Calc ratio = Calc(H) / Calc(S);
+	Calc pow_mu = std::pow(ratio, Calc(2) * mu);
+	Calc pow_mu1 = pow_mu * ratio * ratio;
+
+	Calc Sc = Calc(S) * Calc(cf);
+	Calc Kd = Calc(K) * Calc(df);
+
+	Calc A = phi * Sc * NormalCDF(phi * x1) - phi * Kd * NormalCDF(phi * x1 - phi * vol);
+	Calc B = phi * Sc * NormalCDF(phi * x2) - phi * Kd * NormalCDF(phi * x2 - phi * vol);
+	Calc C = phi * Sc * pow_mu1 * NormalCDF(eta * y1) - phi * Kd * pow_mu * NormalCDF(eta * y1 - eta * vol);
+	Calc D = phi * Sc * pow_mu1 * NormalCDF(eta * y2) - phi * Kd * pow_mu * NormalCDF(eta * y2 - eta * vol);
+	Calc E = Calc(R) * Calc(df) * (NormalCDF(eta * x2 - eta * vol) - pow_mu * NormalCDF(eta * y2 - eta * vol));
+	Calc F = Calc(R) * (std::pow(ratio, mu + lambda) * NormalCDF(eta * z) + std::pow(ratio, mu - lambda) * NormalCDF(eta * z - Calc(2) * eta * lambda * vol));
+
+	// The barrier has already been hit
+	if (down ? S <= H : S >= H) {
+		return in ? Acc(A) : R;
+	}
+
+	// Whether the strike is above the barrier, and whether the option pays when the spot moves towards the barrier
+	bool above = K > H;
+	bool towards = call != down;
+
+	Calc value;
+
+	if (in) {
+
+		if (towards) {
+			value = above != down ? A : B - C + D;
+		}
+
+		else {
+			value = above == down ? C : A - B + D;
+		}
+
+		value += E;
+	}
+
+	else {
+
+		if (towards) {
+			value = above != down ? Calc(0) : A - B + C - D;
+		}
+
+		else {
+			value = above == down ? A - C : B - D;
+		}
+
+		value += F;
+	}
+
+	return Acc(value);
+}
+
+
+
+// Batch kernel that prices the calls and puts of n options stored as arrays (one array per parameter)
+// The loop has no branches so that the compiler can vectorize it
+template <typename Calc, typename Acc = Calc>
+void EuropeanPriceBatch(const int& n, const Acc* S, const Acc* K, const Acc* T, const Acc* r, const Acc* b, const Acc* sig, Acc* call, Acc* put) {
+
+	for (int i = 0; i < n; ++i) {
+
+		Acc df = std::exp(-r[i] * T[i]);
+		Acc cf = std::exp((b[i] - r[i]) * T[i]);
+
+		call[i] = EuropeanCall<Calc, Acc>(S[i], K[i], T[i], b[i], sig[i], df, cf);
+		put[i] = EuropeanPut<Calc, Acc>(S[i], K[i], T[i], b[i], sig[i], df, cf);
+	}
+}
+
+
+// Batch kernel that computes the call deltas, the put deltas, and the gammas of n options stored as arrays
+template <typename Calc, typename Acc = Calc>
+void EuropeanGreeksBatch(const int& n, const Acc* S, const Acc* K, const Acc* T, const Acc* r, const Acc* b, const Acc* sig, Acc* delta_call, Acc* delta_put, Acc* gamma) {
+
+	for (int i = 0; i < n; ++i) {
+
+		Acc cf = std::exp((b[i] - r[i]) * T[i]);
+
+		delta_call[i] = EuropeanDelta<Calc, Acc>(true, S[i], K[i], T[i], b[i], sig[i], cf);
+		delta_put[i] = delta_call[i] - cf;
+		gamma[i] = EuropeanGamma<Calc, Acc>(S[i], K[i], T[i], b[i], sig[i], cf);
+	}
+}
+
+
+// Batch kernels of n options of one style that are all calls or all puts, for books that are grouped by style and side
+// The side is a template parameter, so each of the 4 kernels is compiled without the branch on it and only computes its own side
+template <bool Call, typename Calc, typename Acc = Calc>
+void EuropeanSideBatch(const int& n, const Acc* S, const Acc* K, const Acc* T, const Acc* r, const Acc* b, const Acc* sig, Acc* out) {
+
+	for (int i = 0; i < n; ++i) {
+
+		Acc df = std::exp(-r[i] * T[i]);
+		Acc cf = std::exp((b[i] - r[i]) * T[i]);
+
+		if constexpr (Call) {
+			out[i] = EuropeanCall<Calc, Acc>(S[i], K[i], T[i], b[i], sig[i], df, cf);
+		}
+		else {
+			out[i] = EuropeanPut<Calc, Acc>(S[i], K[i], T[i], b[i], sig[i], df, cf);
+		}
+	}
+}
+
+template <bool Call, typename Calc, typename Acc = Calc>
+void EuropeanSideGreeksBatch(const int& n, const Acc* S, const Acc* K, const Acc* T, const Acc* r, const Acc* b, const Acc* sig, Acc* delta, Acc* gamma) {
+
+	for (int i = 0; i < n; ++i) {
+
+		Acc cf = std::exp((b[i] - r[i]) * T[i]);
+
+		delta[i] = EuropeanDelta<Calc, Acc>(Call, S[i], K[i], T[i], b[i], sig[i], cf);
+		gamma[i] = EuropeanGamma<Calc, Acc>(S[i], K[i], T[i], b[i], sig[i], cf);
+	}
+}
+
+template <bool Call, typename Calc, typename Acc = Calc>
+void PerpetualSideBatch(const int& n, const Acc* S, const Acc* K, const Acc* r, const Acc* b, const Acc* sig, Acc* out) {
+
+	for (int i = 0; i < n; ++i) {
+
+		if constexpr (Call) {
+			out[i] = PerpetualCall<Calc, Acc>(S[i], K[i], r[i], b[i], sig[i]);
+		}
+		else {
+			out[i] = PerpetualPut<Calc, Acc>(S[i], K[i], r[i], b[i], sig[i]);
+		}
+	}
+}
+
+// The delta and the gamma are the ones of the scalar kernels, so the batch and the scalar greeks share one formula, and each option is priced once
+template <bool Call, typename Calc, typename Acc = Calc>
+void PerpetualSideGreeksBatch(const int& n, const Acc* S, const Acc* K, const Acc* r, const Acc* b, const Acc* sig, Acc* delta, Acc* gamma) {
+
+	for (int i = 0; i < n; ++i) {
+		PerpetualGreeks<Calc, Acc>(Call, S[i], K[i], r[i], b[i], sig[i], delta[i], gamma[i]);
+	}
+}
+
+
+
+// Batch kernel that prices the calls and puts of a sweep, where n options share every parameter except the one at Index
+// base holds S, K, T, r, b, and sig, in the order of the Vector of a EuropeanOption, and values holds the swept parameter of each option
+// Each specialization computes the terms that do not depend on the swept parameter once, outside the loop:
+// 0 (S): only log(S) is computed per option, 1 (K): only log(K), 2 (T): sqrt(T) and the 2 factors,
+// 3 (r): only one exponential, since d1 and d2 do not depend on r and cf = exp(b * T) * df, 4 (b): the drift and cf,
+// 5 (sig): only d1 and d2, and 6 (q): nothing, since the dividend rate does not enter the price
+template <int Index, typename Calc, typename Acc = Calc>
+void EuropeanSweepBatch(const int& n, const Acc* base, const Acc* values, Acc* call, Acc* put) {
+
+	Calc S = Calc(base[0]), K = Calc(base[1]), T = Calc(base[2]), r = Calc(base[3]), b = Calc(base[4]), sig = Calc(base[5]);
+
+	Calc log_S = std::log(S), log_K = std::log(K), log_SK = std::log(S / K);
+	Calc root_T = std::sqrt(T), tmp = sig * root_T, half_var = sig * sig * Calc(0.5);
+	Calc df = std::exp(-r * T), cf = std::exp((b - r) * T);
+	Calc drift = (b + half_var) * T;
+	Calc d1 = (log_SK + drift) / tmp, d2 = d1 - tmp;
+	Calc n1 = NormalCDF(d1), n2 = NormalCDF(d2), m1 = NormalCDF(-d1), m2 = NormalCDF(-d2);
+
+	for (int i = 0; i < n; ++i) {
+
+		Calc x = Calc(values[i]);
+
+		if constexpr (Index == 0) {
+			Calc e1 = (std::log(x) - log_K + drift) / tmp, e2 = e1 - tmp;
+			call[i] = Acc(x * NormalCDF(e1) * cf - K * df * NormalCDF(e2));
+			put[i] = Acc(K * NormalCDF(-e2) * df - x * NormalCDF(-e1) * cf);
+		}
+
+		else if constexpr (Index == 1) {
+			Calc e1 = (log_S - std::log(x) + drift) / tmp, e2 = e1 - tmp;
+			call[i] = Acc(S * NormalCDF(e1) * cf - x * df * NormalCDF(e2));
+			put[i] = Acc(x * NormalCDF(-e2) * df - S * NormalCDF(-e1) * cf);
+		}
+
+		else if constexpr (Index == 2) {
+			Calc v = sig * std::sqrt(x);
+			Calc e1 = (log_SK + (b + half_var) * x) / v, e2 = e1 - v;
+			Calc dfx = std::exp(-r * x), cfx = std::exp((b - r) * x);
+			call[i] = Acc(S * NormalCDF(e1) * cfx - K * dfx * NormalCDF(e2));
+			put[i] = Acc(K * NormalCDF(-e2) * dfx - S * NormalCDF(-e1) * cfx);
+		}
+
+		else if constexpr (Index == 3) {
+			Calc dfx = std::exp(-x * T), cfx = std::exp(b * T) * dfx;
+			call[i] = Acc(S * n1 * cfx - K * dfx * n2);
+			put[i] = Acc(K * m2 * dfx - S * m1 * cfx);
+		}
+
+		else if constexpr (Index == 4) {
+			Calc e1 = (log_SK + (x + half_var) * T) / tmp, e2 = e1 - tmp;
+			Calc cfx = std::exp((x - r) * T);
+			call[i] = Acc(S * NormalCDF(e1) * cfx - K * df * NormalCDF(e2));
+			put[i] = Acc(K * NormalCDF(-e2) * df - S * NormalCDF(-e1) * cfx);
+		}
+
+		else if constexpr (Index == 5) {
+			Calc v = x * root_T;
+			Calc e1 = (log_SK + (b + x * x * Calc(0.5)) * T) / v, e2 = e1 - v;
+			call[i] = Acc(S * NormalCDF(e1) * cf - K * df * NormalCDF(e2));
+			put[i] = Acc(K * NormalCDF(-e2) * df - S * NormalCDF(-e1) * cf);
+		}
+
+		else {
+			call[i] = Acc(S * n1 * cf - K * df * n2);
+			put[i] = Acc(K * m2 * df - S * m1 * cf);
+		}
+	}
+}
+
+// Batch kernel that computes the higher order greeks of n options stored as arrays
+// Every output is the same for calls and puts except charm, which has one array for each
+template <typename Calc, typename Acc = Calc>
+void EuropeanHigherGreeksBatch(const int& n, const Acc* S, const Acc* K, const Acc* T, const Acc* r, const Acc* b, const Acc* sig, Acc* vanna, Acc* volga, Acc* charm_call, Acc* charm_put, Acc* speed, Acc* zomma, Acc* color) {
+
+	for (int i = 0; i < n; ++i) {
+
+		Acc cf = std::exp((b[i] - r[i]) * T[i]);
+
+		HigherOrderGreeks<Acc> greeks = EuropeanHigherGreeks<Calc, Acc>(true, S[i], K[i], T[i], r[i], b[i], sig[i], cf);
+
+		vanna[i] = greeks.vanna;
+		volga[i] = greeks.volga;
+		charm_call[i] = greeks.charm;
+		charm_put[i] = greeks.charm + cf * (b[i] - r[i]);
+		speed[i] = greeks.speed;
+		zomma[i] = greeks.zomma;
+		color[i] = greeks.color;
+	}
+}
+
+// Batch kernel that prices the cash-or-nothing and asset-or-nothing calls and puts of n options stored as arrays
+// The cash-or-nothing options pay cash[i], and the asset-or-nothing options pay one unit of the asset
+template <typename Calc, typename Acc = Calc>
+void DigitalPriceBatch(const int& n, const Acc* S, const Acc* K, const Acc* T, const Acc* r, const Acc* b, const Acc* sig, const Acc* cash, Acc* cash_call, Acc* cash_put, Acc* asset_call, Acc* asset_put) {
+
+	for (int i = 0; i < n; ++i) {
+
+		Acc df = std::exp(-r[i] * T[i]);
+		Acc cf = std::exp((b[i] - r[i]) * T[i]);
+
+		Calc d1 = GeneralizedD1<Calc, Acc>(S[i], K[i], T[i], b[i], sig[i]);
+		Calc d2 = d1 - Calc(sig[i]) * std::sqrt(Calc(T[i]));
+
+		// The calls and puts of each kind share d1 and d2, and N(-x) = 1 - N(x)
+		Acc n1 = Acc(NormalCDF(d1));
+		Acc n2 = Acc(NormalCDF(d2));
+
+		cash_call[i] = cash[i] * df * n2;
+		cash_put[i] = cash[i] * df * (Acc(1) - n2);
+		asset_call[i] = S[i] * cf * n1;
+		asset_put[i] = S[i] * cf * (Acc(1) - n1);
+	}
+}
+
+
+// Batch kernel that prices n single barrier options of one type and side stored as arrays
+template <typename Calc, typename Acc = Calc>
+void BarrierPriceBatch(const int& n, const BarrierType& type, const bool& call, const Acc* S, const Acc* K, const Acc* H, const Acc* R, const Acc* T, const Acc* r, const Acc* b, const Acc* sig, Acc* out) {
+
+	for (int i = 0; i < n; ++i) {
+
+		Acc df = std::exp(-r[i] * T[i]);
+		Acc cf = std::exp((b[i] - r[i]) * T[i]);
+
+		out[i] = Barrier<Calc, Acc>(type, call, S[i], K[i], H[i], R[i], T[i], r[i], b[i], sig[i], df, cf);
+	}
+}
+
+
+// Double precision batch entry points
+void PriceBatch(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* call, double* put);
+void GreeksBatch(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* delta_call, double* delta_put, double* gamma);
+
+// Single precision batch entry points
+void PriceBatch(const int& n, const float* S, const float* K, const float* T, const float* r, const float* b, const float* sig, float* call, float* put);
+void GreeksBatch(const int& n, const float* S, const float* K, const float* T, const float* r, const float* b, const float* sig, float* delta_call, float* delta_put, float* gamma);
+
+// Double precision batch entry point of the sweep kernels
+// index selects the specialization of EuropeanSweepBatch, and any index outside 0 to 6 prices nothing
+void SweepBatch(const int& n, const int& index, const double* base, const double* values, double* call, double* put);
+
+// Double and single precision batch entry points of the higher order greeks
+void HigherGreeksBatch(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* vanna, double* volga, double* charm_call, double* charm_put, double* speed, double* zomma, double* color);
+void HigherGreeksBatch(const int& n, const float* S, const float* K, const float* T, const float* r, const float* b, const float* sig, float* vanna, float* volga, float* charm_call, float* charm_put, float* speed, float* zomma, float* color);
+
+// Mixed precision batch entry points: double inputs and outputs, with d1, d2, and the CDF computed in single precision
+void PriceBatchMixed(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* call, double* put);
+void GreeksBatchMixed(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* delta_call, double* delta_put, double* gamma);
+
+// Double and single precision batch entry points of the digital and barrier kernels
+void DigitalBatch(const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, const double* cash, double* cash_call, double* cash_put, double* asset_call, double* asset_put);
+void DigitalBatch(const int& n, const float* S, const float* K, const float* T, const float* r, const float* b, const float* sig, const float* cash, float* cash_call, float* cash_put, float* asset_call, float* asset_put);
+void BarrierBatch(const int& n, const BarrierType& type, const bool& call, const double* S, const double* K, const double* H, const double* R, const double* T, const double* r, const double* b, const double* sig, double* out);
+void BarrierBatch(const int& n, const BarrierType& type, const bool& call, const float* S, const float* K, const float* H, const float* R, const float* T, const float* r, const float* b, const float* sig, float* out);
+
+// A global function that outputs the accuracy of the single and mixed precision kernels against double precision
+// The reference batches from the main function are checked first, followed by n random options
+void PrecisionReport(const int& n);
+
+
+
+#endif
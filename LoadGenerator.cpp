@@ -0,0 +1,248 @@
+// Objective: Implement the LoadGenerator class
+
+// Include the necessary header files
+#include "LoadGenerator.hpp"
+#include "PricingServer.hpp"
+#include "Serialization.hpp"
+#include "Exception.hpp"
+#include <iostream>
+using namespace std;
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <cmath>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/socket.h>
+#endif
+
+
+
+// Returns the steady clock in seconds
+static double Now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+#ifdef __linux__
+
+// Writes or reads exactly n bytes, throwing a SocketException if the connection ends
+// MSG_NOSIGNAL turns a write to a closed connection into an error instead of a SIGPIPE that ends the process
+static void SendAll(const int& fd, const char* data, std::size_t n) {
+
+	while (n > 0) {
+
+		ssize_t w = send(fd, data, n, MSG_NOSIGNAL);
+
+		if (w <= 0) throw SocketException("the server closed the connection");
+
+		data += w;
+		n -= w;
+	}
+}
+
+static void ReceiveAll(const int& fd, char* data, std::size_t n) {
+
+	while (n > 0) {
+
+		ssize_t r = read(fd, data, n);
+
+		if (r <= 0) throw SocketException("the server closed the connection");
+
+		data += r;
+		n -= r;
+	}
+}
+
+#else
+
+static void SendAll(const int& fd, const char* data, std::size_t n) {}
+static void ReceiveAll(const int& fd, char* data, std::size_t n) {}
+
+#endif
+
+
+
+// Parameter constructor
+LoadGenerator::LoadGenerator(const std::string& address, int clients, int size, int requests) : m_address(address), m_clients(max(1, clients)), m_size(max(1, size)), m_requests(max(1, requests)),
+	m_latencies(), m_seconds(0), m_mismatches(0) {}
+
+
+// Destructor
+LoadGenerator::~LoadGenerator() {}
+
+
+// Copy constructor
+LoadGenerator::LoadGenerator(const LoadGenerator& source) : m_address(source.m_address), m_clients(source.m_clients), m_size(source.m_size), m_requests(source.m_requests),
+	m_latencies(source.m_latencies), m_seconds(source.m_seconds), m_mismatches(source.m_mismatches) {}
+
+
+// Assignment operator
+LoadGenerator& LoadGenerator::operator = (const LoadGenerator& source) {
+
+	if (this == &source) {
+		return *this;
+	}
+
+	m_address = source.m_address;
+	m_clients = source.m_clients;
+	m_size = source.m_size;
+	m_requests = source.m_requests;
+	m_latencies = source.m_latencies;
+	m_seconds = source.m_seconds;
+	m_mismatches = source.m_mismatches;
+
+	return *this;
+}
+
+
+// Runs one client
+// The options pay a dividend yield, since a PerpetualAmericanOption call with b = r is never exercised and has no finite price
+// Every fourth request asks for the greeks, and the others for the prices
+void LoadGenerator::Client(const int& index, std::vector<double>& latencies, int& mismatches) {
+
+	std::mt19937 gen(index + 1);
+	std::uniform_real_distribution<double> spot(80, 120), strike(80, 120), expiry(0.1, 2), rate(0.01, 0.1), yield(0.01, 0.05), vol(0.1, 0.5);
+
+	std::vector<OptionRecord> records(m_size);
+	std::vector<double> values(3 * m_size), expected(3 * m_size);
+
+	int fd = ConnectPricingServer(m_address);
+
+	latencies.reserve(m_requests);
+	mismatches = 0;
+
+	for (int k = 0; k < m_requests; ++k) {
+
+		for (int i = 0; i < m_size; ++i) {
+
+			OptionRecord& rec = records[i];
+
+			rec.S = spot(gen);
+			rec.K = strike(gen);
+			rec.r = rate(gen);
+			rec.b = rec.r - yield(gen);
+			rec.sig = vol(gen);
+			rec.q = 0;
+			rec.call = i % 2;
+			rec.style = i % 8 == 7 ? RECORD_PAO : RECORD_EO;
+			rec.T = rec.style == RECORD_EO ? expiry(gen) : 0;
+		}
+
+		PricingRequest request = { PRICING_MAGIC, k % 4 == 3 ? unsigned(OP_GREEKS) : unsigned(OP_PRICE), unsigned(m_size), unsigned(k) };
+		int n = ResponseValues(request.op, request.count);
+
+		double start = Now();
+
+		SendAll(fd, reinterpret_cast<const char*>(&request), sizeof(request));
+		SendAll(fd, reinterpret_cast<const char*>(&records[0]), m_size * sizeof(OptionRecord));
+
+		PricingResponse response;
+		ReceiveAll(fd, reinterpret_cast<char*>(&response), sizeof(response));
+		ReceiveAll(fd, reinterpret_cast<char*>(&values[0]), n * sizeof(double));
+
+		latencies.push_back((Now() - start) * 1e9);
+
+		if (response.magic != PRICING_MAGIC || response.id != request.id || response.count != request.count) {
+			CloseSocket(fd);
+			throw SocketException("the server sent a response that does not match the request");
+		}
+
+		PriceRecords(m_size, &records[0], &expected[0]);
+
+		if (request.op == OP_GREEKS) {
+			GreeksRecords(m_size, &records[0], &expected[m_size], &expected[2 * m_size]);
+		}
+
+		for (int i = 0; i < n; ++i) {
+			mismatches += values[i] != expected[i];
+		}
+	}
+
+	CloseSocket(fd);
+}
+
+
+// Runs every client against the server, one thread per client
+// The first error of a client is thrown again once every client has finished
+void LoadGenerator::Run() {
+
+	std::vector<std::vector<double>> latencies(m_clients);
+	std::vector<int> mismatches(m_clients, 0);
+	std::vector<std::exception_ptr> errors(m_clients);
+	std::vector<std::thread> clients;
+
+	double start = Now();
+
+	for (int c = 0; c < m_clients; ++c) {
+
+		clients.push_back(std::thread([this, c, &latencies, &mismatches, &errors]() {
+			try {
+				this->Client(c, latencies[c], mismatches[c]);
+			}
+			catch (...) {
+				errors[c] = std::current_exception();
+			}
+		}));
+	}
+
+	for (int c = 0; c < m_clients; ++c) {
+		clients[c].join();
+	}
+
+	m_seconds = Now() - start;
+	m_latencies.clear();
+	m_mismatches = 0;
+
+	for (int c = 0; c < m_clients; ++c) {
+
+		if (errors[c]) std::rethrow_exception(errors[c]);
+
+		m_latencies.insert(m_latencies.end(), latencies[c].begin(), latencies[c].end());
+		m_mismatches += mismatches[c];
+	}
+
+	std::sort(m_latencies.begin(), m_latencies.end());
+}
+
+
+// Returns a percentile of the latencies
+double LoadGenerator::Percentile(const double& p) const {
+
+	if (m_latencies.empty()) return 0;
+
+	int index = min(int(m_latencies.size()) - 1, int(std::ceil(p * m_latencies.size())) - 1);
+
+	return m_latencies[max(0, index)];
+}
+
+
+// Returns the number of requests and of records priced per second
+double LoadGenerator::RequestsPerSecond() const {
+	return m_latencies.size() / m_seconds;
+}
+
+double LoadGenerator::RecordsPerSecond() const {
+	return m_latencies.size() * double(m_size) / m_seconds;
+}
+
+
+// Returns the number of values that did not match
+int LoadGenerator::Mismatches() const {
+	return m_mismatches;
+}
+
+
+// Outputs the report of the last run
+void LoadGenerator::Report() const {
+
+	std::cout << m_clients << " clients x " << m_requests << " requests of " << m_size << " records against " << m_address << endl;
+	std::cout << "Requests/s: " << RequestsPerSecond() << '\t' << "Records/s: " << RecordsPerSecond() << endl;
+	std::cout << "Latency p50: " << Percentile(0.5) / 1e3 << " us" << '\t' << "p99: " << Percentile(0.99) / 1e3 << " us" << '\t' << "p999: " << Percentile(0.999) / 1e3 << " us" << endl;
+	std::cout << "Values that do not match the client: " << m_mismatches << endl;
+}
@@ -0,0 +1,76 @@
+// Objective: Create the LoadGenerator class that measures the throughput and latency of a PricingServer
+
+// Ensure no errors if the header file is used twice
+#ifndef LOADGENERATOR_HPP
+#define LOADGENERATOR_HPP
+
+// Include header files
+#include "Serialization.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+
+// Create the LoadGenerator class
+// Each client thread opens its own connection and sends requests of random EuropeanOption and PerpetualAmericanOption records one after the other,
+// waiting for each response before it sends the next request, and the latency of every request is kept
+// The values of every response are checked against PriceRecords and GreeksRecords in the client
+class LoadGenerator {
+private:
+
+	// The address of the server
+	std::string m_address;
+
+	// The number of clients, the number of records per request, and the number of requests per client
+	int m_clients;
+	int m_size;
+	int m_requests;
+
+	// The latencies of every request of the last run in nanoseconds, sorted
+	std::vector<double> m_latencies;
+
+	// The wall-clock time of the last run in seconds, and the number of values that did not match
+	double m_seconds;
+	int m_mismatches;
+
+	// Runs one client and appends its latencies
+	void Client(const int& index, std::vector<double>& latencies, int& mismatches);
+
+public:
+
+	// Parameter constructor with the address, the number of clients, the number of records per request, and the number of requests per client
+	LoadGenerator(const std::string& address, int clients, int size, int requests);
+
+	// Destructor
+	virtual ~LoadGenerator();
+
+	// Copy constructor
+	LoadGenerator(const LoadGenerator& source);
+
+	// Assignment operator
+	LoadGenerator& operator = (const LoadGenerator& source);
+
+	// Runs every client against the server
+	// Throws a SocketException if a client cannot connect or the server closes a connection
+	void Run();
+
+	// Returns the latency in nanoseconds below which the given fraction of the requests finished
+	double Percentile(const double& p) const;
+
+	// Returns the number of requests and of records priced per second
+	double RequestsPerSecond() const;
+	double RecordsPerSecond() const;
+
+	// Returns the number of values that did not match the values computed in the client
+	int Mismatches() const;
+
+	// Outputs the report of the last run
+	void Report() const;
+
+};
+
+
+
+#endif
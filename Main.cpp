@@ -7,12 +7,40 @@
 #include "Matrix.hpp"
 #include "Exception.hpp"
 #include "Greeks.hpp"
+#include "Curve.hpp"
+#include "Kernels.hpp"
+#include "Arena.hpp"
+#include "Instrumentation.hpp"
+#include "Benchmark.hpp"
+#include "ChebyshevProxy.hpp"
+#include "ScenarioEngine.hpp"
+#include "GridPricer.hpp"
+#include "TimeProjection.hpp"
+#include "QuoteChecks.hpp"
+#include "Serialization.hpp"
+#include "PricingServer.hpp"
+#include "LoadGenerator.hpp"
+#include "SharedRing.hpp"
+#include "Pipeline.hpp"
+#include "BumpGreeks.hpp"
+#include "SensitivityEngine.hpp"
+#include "Sweep.hpp"
+#include "ResultEmitter.hpp"
+#include "Allocations.hpp"
+#include "OptionBook.hpp"
 #include "boost/tuple/tuple.hpp"
 #include "boost/tuple/tuple_io.hpp"
 using boost::tuple;
 #include <vector>
 #include <cmath>
 #include <iostream>
+#include <string>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <cstdlib>
+#include <fstream>
+#include <cstdio>
 using namespace std;
 
 
@@ -42,7 +70,91 @@ std::vector<double> Mesh(const double& a, const double& b, const double& n) {
 
 
 
-int main() {
+int main(int argc, char* argv[]) {
+
+	// Run the benchmarks instead of the outputs below when the program is started with "bench"
+	// "bench perf" also reads the hardware performance counters around each workload
+	if (argc > 1 && std::string(argv[1]) == "bench") {
+
+		Benchmark bench(1000000, argc > 2 && std::string(argv[2]) == "perf");
+		bench.Run();
+
+		return 0;
+	}
+
+	// Measure the heap allocations per call of the pricing APIs when the program is started with "allocations [calls]"
+	// The program must be compiled with ALLOCATION_TRACKING, and it returns 1 if a certified allocation-free path allocated or if tracking is not compiled in
+	if (argc > 1 && std::string(argv[1]) == "allocations") {
+		return AllocationReport(argc > 2 ? std::atoi(argv[2]) : 100) != 0 ? 1 : 0;
+	}
+
+	// Run a pricing server when the program is started with "server [address] [workers] [batch]", until Enter is pressed
+	// An address that starts with '/' is a Unix socket path, and any other address is a TCP port on the loopback interface
+	if (argc > 1 && std::string(argv[1]) == "server") {
+
+		try {
+
+			PricingServer server(argc > 2 ? argv[2] : "/tmp/bscf-pricer.sock", argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency(), argc > 4 ? std::atoi(argv[4]) : 256);
+			server.Start();
+
+			std::cout << "Pricing server listening on " << server.Address() << ", press Enter to stop" << endl;
+			std::cin.get();
+
+			server.Stop();
+
+			std::cout << server.Requests() << " requests, " << server.Records() << " records, " << server.Batches() << " batches" << endl;
+		}
+		catch (ArrayException& e) {
+			std::cout << e.GetMessage();
+			return 1;
+		}
+
+		return 0;
+	}
+
+	// Measure the shared memory rings when the program is started with "ring [producers] [batch] [rounds]"
+	if (argc > 1 && std::string(argv[1]) == "ring") {
+
+		try {
+			RingBenchmark(argc > 2 ? std::atoi(argv[2]) : 4, argc > 3 ? std::atoi(argv[3]) : 16, argc > 4 ? std::atoi(argv[4]) : 20000);
+		}
+		catch (ArrayException& e) {
+			std::cout << e.GetMessage();
+			return 1;
+		}
+
+		return 0;
+	}
+
+	// Run the load generator when the program is started with "loadgen [address] [clients] [size] [requests]"
+	// Without an address, or with the address "local", a server is started in this process on a temporary Unix socket
+	if (argc > 1 && std::string(argv[1]) == "loadgen") {
+
+		try {
+
+			std::string address = argc > 2 ? argv[2] : "local";
+			PricingServer local("/tmp/bscf-loadgen.sock", std::thread::hardware_concurrency(), 256);
+
+			if (address == "local") {
+				local.Start();
+				address = local.Address();
+			}
+
+			LoadGenerator load(address, argc > 3 ? std::atoi(argv[3]) : 8, argc > 4 ? std::atoi(argv[4]) : 16, argc > 5 ? std::atoi(argv[5]) : 20000);
+			load.Run();
+			load.Report();
+
+			if (local.Batches() > 0) {
+				std::cout << "Records per batch in the server: " << double(local.Records()) / local.Batches() << endl;
+			}
+		}
+		catch (ArrayException& e) {
+			std::cout << e.GetMessage();
+			return 1;
+		}
+
+		return 0;
+	}
 
 	// Calculate the call and put prices for 4 batches of option parameters
 	// Confirm the Put-Call Parity holds using the EuropeanOption method: InternalConfirmPutCallParity
@@ -443,5 +555,708 @@ int main() {
 	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl
 		<< "///////////////////////////////////////////////////////////////////////////////////////////" << endl;
 
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Price European Options that reference the pillars of a yield curve and a cost of carry curve
+	// The discount and forward factors of each pillar are computed once by the curves and looked up by every option on that pillar
+
+	std::cout << endl << "Outputs for European Options on term-structure curves:" << endl << endl;
+
+	// The options share the curves, so the curves live as long as any option or copy of an option that references them
+	std::shared_ptr<Curve> yield = std::make_shared<Curve>(std::vector<double>{ 0.25, 1.0, 30.0 }, std::vector<double>{ 0.08, 0.12, 0.08 });
+	std::shared_ptr<Curve> carry = std::make_shared<Curve>(std::vector<double>{ 0.25, 1.0, 30.0 }, std::vector<double>{ 0.08, 0.12, 0.08 });
+
+	// Batches 1, 3, and 4 from above, priced from the pillars with their expiries
+	EuropeanOption curve1(65, yield, carry, yield->Pillar(0.25), 0.3, 0);
+	EuropeanOption curve3(10, yield, carry, yield->Pillar(1.0), 0.5, 0);
+	EuropeanOption curve4(100, yield, carry, yield->Pillar(30.0), 0.3, 0);
+
+	// A perpetual put on the first pillar reads the same rates
+	PerpetualAmericanOption curve_perpetual(100, yield, carry, yield->Pillar(0.25), 0.1, 0);
+	curve_perpetual.Toggle();
+
+	std::cout << "Pillar" << '\t' << "Curve call:" << '\t' << "Flat call:" << endl;
+	std::cout << curve1.Pillar() << '\t' << curve1.Price(S) << '\t' << '\t' << batch1_call.Price(S) << endl;
+	std::cout << curve3.Pillar() << '\t' << curve3.Price(S3) << '\t' << '\t' << batch3_call.Price(S3) << endl;
+	std::cout << curve4.Pillar() << '\t' << curve4.Price(S4) << '\t' << '\t' << batch4_call.Price(S4) << endl;
+
+	// Shift the rates of the first pillar: the options on the pillar reprice with the new rates, the same as flat options with them
+	yield->Rate(0, 0.10);
+	carry->Rate(0, 0.06);
+
+	EuropeanOption shifted(65, 0.25, 0.10, 0.06, 0.3, 0);
+	PerpetualAmericanOption shifted_perpetual(100, 0.10, 0.06, 0.1, 0);
+	shifted_perpetual.Toggle();
+
+	std::cout << "Shifted pillar 0, curve call: " << curve1.Price(S) << ", flat call: " << shifted.Price(S) << ", curve delta: " << curve1.Delta(S) << ", flat delta: " << shifted.Delta(S) << endl;
+	std::cout << "Shifted pillar 0, curve perpetual put: " << curve_perpetual.Price(110) << ", flat perpetual put: " << shifted_perpetual.Price(110) << endl;
+
+	yield->Rate(0, 0.08);
+	carry->Rate(0, 0.08);
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Report the accuracy of the single precision and mixed precision kernels against the double precision kernels
+
+	std::cout << "Outputs for the single and mixed precision kernels:" << endl << endl;
+
+	PrecisionReport(100000);
+
+	std::cout << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Run the 6 European Option sweeps from Group A.d1 with their rows and result buffers drawn from an Arena
+	// The Arena is reset between sweeps, so the same blocks are reused and the global heap is only used for the first sweep
+
+	std::cout << "Outputs for Matrix sweeps drawn from an Arena:" << endl << endl;
+
+	Arena arena;
+	double ends[6] = { end, end, 1, 0.4, 0.4, 0.8 };
+
+	for (int i = 0; i < 6; ++i) {
+
+		// The Matrix is scoped so that it is destroyed before the Arena is reset
+		{
+			Matrix sweep(option, start, i, ends[i], n, &arena);
+
+			double* calls = arena.Allocate<double>(sweep.GetSize());
+			double* puts = arena.Allocate<double>(sweep.GetSize());
+
+			sweep.MatrixPricer(calls, puts);
+
+			std::cout << "Index " << i << ": last call " << calls[sweep.GetSize() - 1] << ", last put " << puts[sweep.GetSize() - 1] << ", bytes used " << arena.Used() << endl;
+		}
+
+		arena.Reset();
+	}
+
+	std::cout << "Peak Arena usage: " << arena.Peak() << " bytes out of " << arena.Capacity() << " bytes" << endl;
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Output the call counts and latency histograms recorded by the probes during the run above
+	// The probes are only compiled in when INSTRUMENTATION is defined
+
+#ifdef INSTRUMENTATION
+
+	std::cout << "Outputs for the hot-path instrumentation:" << endl << endl;
+
+	std::cout << Instrumentation::Text() << endl;
+	std::cout << Instrumentation::Json() << endl << endl;
+
+	std::cout << "Cost of one probe: " << Instrumentation::ProbeOverhead(1000000) << " ns" << endl;
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+#endif
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Revalue the 4 batches under 10000 spot scenarios with Chebyshev proxies fitted over +/- 50% of their spot prices
+	// Batch 3 is deep out of the money with a short expiry, so a degree 8 fit does not meet the tolerance and falls back to exact pricing
+
+	std::cout << "Outputs for Chebyshev proxy scenario revaluation:" << endl << endl;
+
+	EuropeanOption positions[4] = { batch1_call, batch2_call, batch3_call, batch4_call };
+	double spots[4] = { S, S2, S3, S4 };
+	int degrees[4] = { 24, 24, 8, 24 };
+
+	std::cout << "Batch:" << '\t' << "Error bound:" << '\t' << "Proxy used:" << '\t' << "Max error:" << endl;
+
+	for (int i = 0; i < 4; ++i) {
+
+		ChebyshevProxy proxy(positions[i], 0.5 * spots[i], 1.5 * spots[i], degrees[i], 1e-6);
+
+		// Scenario spot prices spread over the range of the proxy
+		std::vector<double> scenarios = Mesh(0.5 * spots[i], 1.5 * spots[i], 9999);
+		std::vector<double> values(scenarios.size());
+
+		proxy.PriceScenarios(&scenarios[0], &values[0], scenarios.size());
+
+		double error = 0;
+
+		for (int j = 0; j < scenarios.size(); ++j) {
+			error = max(error, abs(values[j] - positions[i].Price(scenarios[j])));
+		}
+
+		std::cout << i + 1 << '\t' << proxy.ErrorBound() << '\t' << proxy.Accurate() << '\t' << '\t' << error << endl;
+	}
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Revalue a book of the 4 batches, long the calls and short the puts, under 10000 random spot, vol, and rate scenarios
+
+	std::cout << "Outputs for the scenario engine:" << endl << endl;
+
+	ScenarioEngine engine;
+
+	for (int i = 0; i < 4; ++i) {
+
+		EuropeanOption put = positions[i];
+		put.Toggle();
+
+		engine.AddPosition(positions[i], spots[i], 100);
+		engine.AddPosition(put, spots[i], -50);
+	}
+
+	// Scenarios with a fixed seed so that the outputs can be reproduced
+	std::mt19937 gen(2024);
+	std::normal_distribution<double> spot_shock(0, 0.02), vol_shock(0, 0.01), rate_shock(0, 0.0025);
+
+	std::vector<Scenario> scenarios(10000);
+
+	for (int i = 0; i < scenarios.size(); ++i) {
+		scenarios[i].spot = spot_shock(gen);
+		scenarios[i].vol = vol_shock(gen);
+		scenarios[i].rate = rate_shock(gen);
+	}
+
+	engine.Revalue(scenarios);
+
+	std::cout << "Positions: " << engine.Positions() << ", scenarios: " << scenarios.size() << endl;
+	std::cout << "99% VaR: " << engine.VaR(0.99) << endl;
+	std::cout << "97.5% Expected Shortfall: " << engine.ExpectedShortfall(0.975) << endl;
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Compute the spot x volatility ladder of the option from Group A.a2 in one call
+	// The rows are the spot prices of mesh2 and the columns are the volatilities from 0.2 to 0.5
+
+	std::cout << "Outputs for the spot x volatility grid:" << endl << endl;
+	std::cout << "Ran option with K = 100, T = 0.5, r = 0.1, b = 0, sig = 0.36 " << endl << endl;
+
+	GridPricer grid(option1, S1, 0, mesh2, 5, Mesh(0.2, 0.5, 3), 0);
+	grid.Compute();
+
+	std::cout << "Call prices: " << endl;
+	grid.OutputGrid(grid.Calls());
+
+	std::cout << "Put deltas: " << endl;
+	grid.OutputGrid(grid.DeltaPuts());
+
+	std::cout << "Gammas: " << endl;
+	grid.OutputGrid(grid.Gammas());
+
+	std::cout << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Project the value and greeks of the scenario engine's book week by week over the next 3 months
+	// Batch 1 expires after 0.25 years, so its value settles to its intrinsic value at the last date
+
+	std::cout << "Outputs for the time projection of a book:" << endl << endl;
+
+	TimeProjection projection;
+
+	for (int i = 0; i < 4; ++i) {
+
+		EuropeanOption put = positions[i];
+		put.Toggle();
+
+		projection.AddPosition(positions[i], spots[i], 100);
+		projection.AddPosition(put, spots[i], -50);
+	}
+
+	std::vector<double> dates = Mesh(0, 0.25, 13);
+
+	projection.Project(dates);
+
+	std::cout << "Date:" << '\t' << '\t' << "Book value:" << '\t' << "Book delta:" << '\t' << "Book gamma:" << endl;
+
+	for (int d = 0; d < projection.Dates(); ++d) {
+		std::cout << dates[d] << '\t' << '\t' << projection.BookValue(d) << '\t' << '\t' << projection.BookDelta(d) << '\t' << '\t' << projection.BookGamma(d) << endl;
+	}
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Check a chain of 6 strikes for the option from the Group A.d1 sweeps, priced from the model, after two quotes are moved
+	// The call at K = 60 is raised above its neighbours and the put at K = 70 is raised without moving its call
+
+	std::cout << "Outputs for the batch quote checks:" << endl << endl;
+
+	int chain = 6;
+	std::vector<double> qS(chain, start), qK(chain), qT(chain, 0.25), qr(chain, 0.08), qb(chain, 0.08), qsig(chain, 0.3), qcall(chain), qput(chain);
+	std::vector<unsigned char> flags(chain);
+
+	for (int i = 0; i < chain; ++i) {
+		qK[i] = 45 + 5 * i;
+	}
+
+	PriceBatch(chain, &qS[0], &qK[0], &qT[0], &qr[0], &qb[0], &qsig[0], &qcall[0], &qput[0]);
+
+	qcall[3] += 0.5;
+	qput[5] += 0.1;
+
+	CheckQuotes(chain, &qcall[0], &qput[0], &qS[0], &qK[0], &qT[0], &qr[0], &qb[0], 1e-8, &flags[0]);
+
+	std::cout << "Strike:" << '\t' << "Call:" << '\t' << '\t' << "Put:" << '\t' << '\t' << "Flags:" << endl;
+
+	for (int i = 0; i < chain; ++i) {
+		std::cout << qK[i] << '\t' << qcall[i] << '\t' << '\t' << qput[i] << '\t' << '\t' << int(flags[i]) << endl;
+	}
+
+	std::cout << "Quotes with violations: " << Violations(chain, &flags[0]).size() << endl;
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Write the put of the Group A.c option and the Matrix m10 to a binary stream, read them back, and check that nothing changed
+	// Then write the 4 batches and their puts as a book snapshot, map it, and price it without deserializing
+
+	std::cout << "Outputs for the binary serialization:" << endl << endl;
+
+	std::stringstream stream;
+
+	EuropeanOption saved = option1;
+	saved.Toggle();
+
+	Serialize(stream, saved);
+	Serialize(stream, m10);
+
+	EuropeanOption loaded = DeserializeEuropeanOption(stream);
+	Matrix m10_loaded = DeserializeMatrix(stream);
+
+	std::cout << "Saved option:  " << saved.Description() << endl;
+	std::cout << "Loaded option: " << loaded.Description() << endl;
+	std::cout << "Price of the saved and loaded options: " << saved.Price(S1) << '\t' << loaded.Price(S1) << endl;
+
+	int rows_changed = 0;
+
+	for (int i = 0; i < m10.GetSize(); ++i) {
+		for (int j = 0; j < m10[i].Size(); ++j) {
+			rows_changed += m10[i][j] != m10_loaded[i][j];
+		}
+	}
+
+	std::cout << "Rows of the Matrix: " << m10_loaded.GetSize() << ", values changed: " << rows_changed << endl << endl;
+
+	std::vector<OptionRecord> records;
+
+	for (int i = 0; i < 4; ++i) {
+
+		EuropeanOption put = positions[i];
+		put.Toggle();
+
+		records.push_back(Record(spots[i], positions[i]));
+		records.push_back(Record(spots[i], put));
+	}
+
+	WriteSnapshot("book.snapshot", records);
+
+	std::vector<double> snapshot_prices(records.size());
+
+	// The snapshot is unmapped at the end of the block, before the file is removed
+	{
+		BookSnapshot snapshot("book.snapshot");
+		snapshot.Price(&snapshot_prices[0]);
+	}
+
+	std::remove("book.snapshot");
+
+	std::cout << "Batch:" << '\t' << "Call:" << '\t' << '\t' << "Put:" << endl;
+
+	for (int i = 0; i < 4; ++i) {
+		std::cout << i + 1 << '\t' << snapshot_prices[2 * i] << '\t' << '\t' << snapshot_prices[2 * i + 1] << endl;
+	}
+
+	try {
+		DeserializePerpetualAmericanOption(stream);
+	}
+	catch (ArrayException& e) {
+		std::cout << e.GetMessage();
+	}
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Run the calls and puts of the curve options above through the coroutine pipeline, with batches of 2 options so that the stages overlap
+	// The rates come from the yield and cost of carry curves, and the perpetual puts take the rates of the 30 year pillar
+
+	std::cout << "Outputs for the coroutine pipeline:" << endl << endl;
+
+	std::stringstream pipeline_in, pipeline_out;
+
+	pipeline_in << "EO 1 60 65 0.25 0.3 0" << endl << "EO 0 60 65 0.25 0.3 0" << endl;
+	pipeline_in << "EO 1 5 10 1 0.5 0" << endl << "EO 0 5 10 1 0.5 0" << endl;
+	pipeline_in << "EO 1 100 100 30 0.3 0" << endl << "EO 0 100 100 30 0.3 0" << endl;
+	pipeline_in << "PAO 0 110 100 0.1 0" << endl << "PAO 0 100 100 0.1 0" << endl;
+
+	Pipeline pipeline(*yield, *carry, 2, 2, 2);
+	int piped = pipeline.Run(pipeline_in, pipeline_out);
+
+	std::cout << "Index,Price,Delta,Gamma" << endl << pipeline_out.str();
+	std::cout << "Options written: " << piped << endl;
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Price the digital and barrier examples of Haug, The Complete Guide to Option Pricing Formulas, through the batch kernels
+	// The cash-or-nothing put should be 2.6710, the asset-or-nothing put 20.2069,
+	// and the calls with S = 100, H = 95 or 105, R = 3, T = 0.5, r = 0.08, b = 0.04, sig = 0.25 should match Haug's table
+
+	std::cout << "Outputs for the digital and barrier kernels:" << endl << endl;
+
+	double dS[2] = { 100, 70 }, dK[2] = { 80, 65 }, dT[2] = { 0.75, 0.5 }, dr[2] = { 0.06, 0.07 }, db[2] = { 0, 0.02 }, dsig[2] = { 0.35, 0.27 }, dcash[2] = { 10, 10 };
+	double cash_call[2], cash_put[2], asset_call[2], asset_put[2];
+
+	DigitalBatch(2, dS, dK, dT, dr, db, dsig, dcash, cash_call, cash_put, asset_call, asset_put);
+
+	std::cout << "Cash-or-nothing put: " << cash_put[0] << endl;
+	std::cout << "Asset-or-nothing put: " << asset_put[1] << endl << endl;
+
+	double bS[3] = { 100, 100, 100 }, bK[3] = { 90, 100, 110 }, bR[3] = { 3, 3, 3 }, bT[3] = { 0.5, 0.5, 0.5 }, br[3] = { 0.08, 0.08, 0.08 }, bb[3] = { 0.04, 0.04, 0.04 }, bsig[3] = { 0.25, 0.25, 0.25 };
+	double down[3] = { 95, 95, 95 }, up[3] = { 105, 105, 105 };
+	double down_in[3], down_out[3], up_in[3], up_out[3];
+
+	BarrierBatch(3, BARRIER_DOWN_IN, true, bS, bK, down, bR, bT, br, bb, bsig, down_in);
+	BarrierBatch(3, BARRIER_DOWN_OUT, true, bS, bK, down, bR, bT, br, bb, bsig, down_out);
+	BarrierBatch(3, BARRIER_UP_IN, true, bS, bK, up, bR, bT, br, bb, bsig, up_in);
+	BarrierBatch(3, BARRIER_UP_OUT, true, bS, bK, up, bR, bT, br, bb, bsig, up_out);
+
+	std::cout << "Strike:" << '	' << "Down-in:" << '	' << "Down-out:" << '	' << "Up-in:" << '	' << '	' << "Up-out:" << endl;
+
+	for (int i = 0; i < 3; ++i) {
+		std::cout << bK[i] << '	' << down_in[i] << '	' << '	' << down_out[i] << '	' << '	' << up_in[i] << '	' << '	' << up_out[i] << endl;
+	}
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Compute the higher order greeks of a call and a put with S = 105, K = 100, T = 0.5, r = 0.1, b = 0.05, sig = 0.36 in one evaluation
+	// Each greek is checked against central differences of the exact delta and gamma, bumping S, sig, or T, and volga against the second difference of the price in sig
+	// The put is checked through the batch kernel, which gives the charm of both calls and puts, and b differs from r so that the cf * (b - r) term of the put charm is tested
+
+	std::cout << "Outputs for the higher order greeks:" << endl << endl;
+
+	EuropeanOption higher(100, 0.5, 0.1, 0.05, 0.36, 0);
+	double hS = 105, hs = 1e-4, ht = 1e-5;
+
+	HigherOrderGreeks<double> exact = higher.HigherGreeks(hS);
+
+	EuropeanOption up_vol = higher, down_vol = higher, up_time = higher, down_time = higher;
+	up_vol.Volatility(0.36 + hs);
+	down_vol.Volatility(0.36 - hs);
+	up_time.Expiry(0.5 + ht);
+	down_time.Expiry(0.5 - ht);
+
+	// Outputs a greek, its finite difference estimate, and the difference between the two
+	auto greek_row = [](const std::string& name, const double& value, const double& estimate) {
+		std::cout << name << '\t' << value << '\t' << estimate << '\t' << '\t' << value - estimate << endl;
+	};
+
+	std::cout << "Greek:" << '\t' << "Exact:" << '\t' << '\t' << "Finite difference:" << '\t' << "Difference:" << endl;
+	greek_row("Vanna", exact.vanna, (up_vol.Delta(hS) - down_vol.Delta(hS)) / (2 * hs));
+	greek_row("Volga", exact.volga, (up_vol.Price(hS) - 2 * higher.Price(hS) + down_vol.Price(hS)) / (hs * hs));
+	greek_row("Charm", exact.charm, -(up_time.Delta(hS) - down_time.Delta(hS)) / (2 * ht));
+	greek_row("Speed", exact.speed, (higher.Gamma(hS + 0.01) - higher.Gamma(hS - 0.01)) / 0.02);
+	greek_row("Zomma", exact.zomma, (up_vol.Gamma(hS) - down_vol.Gamma(hS)) / (2 * hs));
+	greek_row("Color", exact.color, -(up_time.Gamma(hS) - down_time.Gamma(hS)) / (2 * ht));
+
+	double hK = 100, hT = 0.5, hr = 0.1, hb = 0.05, hsig = 0.36;
+	double vanna, volga, charm_call, charm_put, speed, zomma, color;
+
+	HigherGreeksBatch(1, &hS, &hK, &hT, &hr, &hb, &hsig, &vanna, &volga, &charm_call, &charm_put, &speed, &zomma, &color);
+
+	up_time.Toggle();
+	down_time.Toggle();
+
+	greek_row("Put charm", charm_put, -(up_time.Delta(hS) - down_time.Delta(hS)) / (2 * ht));
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Compute delta and gamma by bumping and repricing with Richardson extrapolation, for a European call from batch 1 and a perpetual American put
+	// The exact European greeks come from the EuropeanOption class and the exact perpetual greeks from the kernels
+	// The step h = 0.1 of the Greeks approximations above is shown for comparison, with 3 prices per delta and gamma
+
+	std::cout << "Outputs for the Richardson bump and reprice greeks:" << endl << endl;
+
+	EuropeanOption bumped_call(65, 0.25, 0.08, 0.08, 0.3, 0);
+	PerpetualAmericanOption bumped_put(100, 0.1, 0.02, 0.1, 0.08);
+	bumped_put.Toggle();
+
+	BumpResult eo_bump = BumpGreeks(bumped_call, 1e-8).Spot(60);
+	BumpResult pao_bump = BumpGreeks(bumped_put, 1e-8).Spot(110);
+
+	double pao_delta = PerpetualDelta<double>(false, 110.0, 100.0, 0.1, 0.02, 0.1);
+	double pao_gamma = PerpetualGamma<double>(false, 110.0, 100.0, 0.1, 0.02, 0.1);
+
+	std::cout << "Option:" << '	' << "Greek:" << '	' << "Exact:" << '	' << '	' << "Richardson error:" << '	' << "h = 0.1 error:" << '	' << '	' << "Prices:" << endl;
+	std::cout << "EO" << '	' << "Delta" << '	' << bumped_call.Delta(60) << '	' << abs(eo_bump.first - bumped_call.Delta(60)) << '	' << '	' << abs(bumped_call.Delta(60, 0.1) - bumped_call.Delta(60)) << '	' << '	' << eo_bump.reprices << endl;
+	std::cout << "EO" << '	' << "Gamma" << '	' << bumped_call.Gamma(60) << '	' << abs(eo_bump.second - bumped_call.Gamma(60)) << '	' << '	' << abs(bumped_call.Gamma(60, 0.1) - bumped_call.Gamma(60)) << endl;
+	std::cout << "PAO" << '	' << "Delta" << '	' << pao_delta << '	' << abs(pao_bump.first - pao_delta) << '	' << '	' << abs((bumped_put.Price(110.1) - bumped_put.Price(109.9)) / 0.2 - pao_delta) << '	' << '	' << pao_bump.reprices << endl;
+	std::cout << "PAO" << '	' << "Gamma" << '	' << pao_gamma << '	' << abs(pao_bump.second - pao_gamma) << '	' << '	' << abs((bumped_put.Price(110.1) - 2 * bumped_put.Price(110) + bumped_put.Price(109.9)) / 0.01 - pao_gamma) << endl;
+
+	// The greeks of the other parameters of the European call from one shared base price, against the closed forms of the generalized model
+
+	BumpSensitivities eo_all = BumpGreeks(bumped_call, 1e-8).All(60);
+
+	double bump_d1 = GeneralizedD1<double>(60.0, 65.0, 0.25, 0.08, 0.3);
+	double bump_d2 = bump_d1 - 0.3 * sqrt(0.25);
+	double carry_factor = exp((0.08 - 0.08) * 0.25);
+	double exact_vega = 60 * carry_factor * NormalPDF(bump_d1) * sqrt(0.25);
+	double exact_rho = -0.25 * bumped_call.Price(60);
+	double exact_carry = 0.25 * 60 * carry_factor * NormalCDF(bump_d1);
+	double exact_theta = -60 * carry_factor * NormalPDF(bump_d1) * 0.3 / (2 * sqrt(0.25)) - (0.08 - 0.08) * 60 * carry_factor * NormalCDF(bump_d1) - 0.08 * 65 * exp(-0.08 * 0.25) * NormalCDF(bump_d2);
+
+	std::cout << endl << "Option:" << '\t' << "Greek:" << '\t' << "Exact:" << '\t' << '\t' << "Richardson error:" << '\t' << "Prices:" << endl;
+	std::cout << "EO" << '\t' << "Vega" << '\t' << exact_vega << '\t' << abs(eo_all.volatility.first - exact_vega) << '\t' << '\t' << eo_all.volatility.reprices << endl;
+	std::cout << "EO" << '\t' << "Rho" << '\t' << exact_rho << '\t' << abs(eo_all.rate.first - exact_rho) << '\t' << '\t' << eo_all.rate.reprices << endl;
+	std::cout << "EO" << '\t' << "Carry" << '\t' << exact_carry << '\t' << abs(eo_all.carry.first - exact_carry) << '\t' << '\t' << eo_all.carry.reprices << endl;
+	std::cout << "EO" << '\t' << "Theta" << '\t' << exact_theta << '\t' << abs(eo_all.time.first - exact_theta) << '\t' << '\t' << eo_all.time.reprices << endl;
+	std::cout << "Prices for every greek with the shared base price: " << eo_all.reprices << endl;
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Compute the sensitivities of every row of a spot sweep of the batch 1 call to S, K, T, r, b, and sig in one pass, and of a spot sweep of a perpetual American put
+	// The deltas and gammas of the European rows are checked against the exact greeks
+
+	std::cout << "Outputs for the sensitivity engine:" << endl << endl;
+
+	Matrix sensitivity_eo(EuropeanOption(65, 0.25, 0.08, 0.08, 0.3, 0), 60, 0, 70, 4);
+	Matrix sensitivity_pao(PerpetualAmericanOption(100, 0.1, 0.02, 0.1, 0.08), 100, 0, 120, 4);
+
+	SensitivityEngine sensitivities;
+	sensitivities.Compute(sensitivity_eo);
+
+	std::cout << "European calls:" << endl;
+	sensitivities.OutputTable(true);
+
+	double delta_error = 0, gamma_error = 0;
+
+	for (int i = 0; i < sensitivities.Rows(); ++i) {
+		EuropeanOption row = sensitivity_eo[i].ConvertToEO();
+		delta_error = max(delta_error, abs(sensitivities.Call(i, SENS_DELTA) - row.Delta(sensitivity_eo[i][0])));
+		gamma_error = max(gamma_error, abs(sensitivities.Call(i, SENS_GAMMA) - row.Gamma(sensitivity_eo[i][0])));
+	}
+
+	std::cout << "Largest delta error: " << delta_error << ", largest gamma error: " << gamma_error << endl << endl;
+
+	sensitivities.Compute(sensitivity_pao);
+
+	std::cout << "Perpetual American puts:" << endl;
+	sensitivities.OutputTable(false);
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Price the spot sweep of Group A.d1 from a Sweep, which stores one row and the swept parameter, and check it against the Matrix of the same rows
+	// Then price a sweep of 10^7 spot prices a range at a time, which would take hundreds of MB as a Matrix
+
+	std::cout << "Outputs for the compact Sweep:" << endl << endl;
+
+	Sweep compact(option, start, 0, end, n);
+	compact.ReadChange(3);
+
+	Matrix full(option, start, 0, end, n);
+	boost::tuple<vector<double>, vector<double>> compact_prices = compact.MatrixPricer(), full_prices = full.MatrixPricer();
+
+	double sweep_error = 0;
+
+	for (int i = 0; i < compact.GetSize(); ++i) {
+		sweep_error = max(sweep_error, abs(boost::tuples::get<0>(compact_prices)[i] - boost::tuples::get<0>(full_prices)[i]));
+		sweep_error = max(sweep_error, abs(boost::tuples::get<1>(compact_prices)[i] - boost::tuples::get<1>(full_prices)[i]));
+	}
+
+	std::cout << "Largest difference from the Matrix: " << sweep_error << endl;
+	std::cout << "Bytes of a Sweep of any length: " << sizeof(Sweep) + 7 * sizeof(double) << ", bytes per row of a Matrix: " << sizeof(Vector) + 7 * sizeof(double) << endl;
+
+	Sweep large(option, 10, 0, 110, 1e7);
+	std::vector<double> large_calls(1 << 16), large_puts(1 << 16);
+	double large_sum = 0;
+
+	for (int first = 0; first < large.GetSize(); first += large_calls.size()) {
+
+		int count = min(int(large_calls.size()), large.GetSize() - first);
+		large.MatrixPricer(first, count, &large_calls[0], &large_puts[0]);
+
+		for (int i = 0; i < count; ++i) {
+			large_sum += large_calls[i] - large_puts[i];
+		}
+	}
+
+	std::cout << "Rows of the large sweep: " << large.GetSize() << ", mean call - put: " << large_sum / large.GetSize() << endl;
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Write the spot sweep above as CSV through a ResultEmitter with 8 significant digits, then read the file back
+
+	std::cout << "Outputs for the CSV emitter:" << endl << endl;
+
+	{
+		ResultEmitter emitter("sweep.csv", CSV, 8, false);
+
+		std::vector<double> emitted_calls = boost::tuples::get<0>(compact_prices), emitted_puts = boost::tuples::get<1>(compact_prices);
+		std::vector<const double*> emitted = { &emitted_calls[0], &emitted_puts[0] };
+
+		emitter.Header({ "Row", "Call", "Put" });
+		emitter.Columns(emitted_calls.size(), emitted, true);
+		emitter.Flush();
+
+		std::cout << "Bytes written: " << emitter.Bytes() << endl;
+	}
+
+	std::ifstream emitted_file("sweep.csv");
+	std::string emitted_line;
+
+	while (std::getline(emitted_file, emitted_line)) {
+		std::cout << emitted_line << endl;
+	}
+
+	emitted_file.close();
+	std::remove("sweep.csv");
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Price a book that mixes EuropeanOption and PerpetualAmericanOption calls and puts through an OptionBook, against pricing each option through the Option base class
+
+	std::cout << "Outputs for the OptionBook:" << endl << endl;
+
+	std::vector<EuropeanOption> book_europeans;
+	std::vector<PerpetualAmericanOption> book_perpetuals;
+
+	for (int i = 0; i < 4; ++i) {
+
+		book_europeans.push_back(EuropeanOption(90 + 10 * i, 0.25 + 0.25 * i, 0.08, 0.08, 0.3, 0));
+		book_perpetuals.push_back(PerpetualAmericanOption(90 + 10 * i, 0.1, 0.02, 0.1, 0));
+
+		if (i % 2) {
+			book_europeans[i].Toggle();
+		}
+
+		if (i / 2) {
+			book_perpetuals[i].Toggle();
+		}
+	}
+
+	OptionBook book;
+	std::vector<const Option*> book_options;
+	std::vector<double> book_spots;
+
+	// Each perpetual is 10 above its strike, so it is in the continuation region where its formula holds
+	// With r = 0.1, b = 0.02, and sig = 0.1 the puts are exercised below S* = 0.86 * K, 94.8 for K = 110 and 103.4 for K = 120, and the calls above 1.45 * K
+	for (int i = 0; i < 4; ++i) {
+
+		double perpetual_spot = book_perpetuals[i].StrikePrice() + 10;
+
+		book.Add(100 + i, book_europeans[i]);
+		book.Add(perpetual_spot, book_perpetuals[i]);
+
+		book_options.push_back(&book_europeans[i]);
+		book_options.push_back(&book_perpetuals[i]);
+
+		book_spots.push_back(100 + i);
+		book_spots.push_back(perpetual_spot);
+	}
+
+	std::vector<double> book_prices(book.Count()), book_deltas(book.Count()), book_gammas(book.Count());
+
+	book.Price(&book_prices[0]);
+	book.Greeks(&book_deltas[0], &book_gammas[0]);
+
+	std::cout << "European calls: " << book.Count(BOOK_EO_CALL) << ", European puts: " << book.Count(BOOK_EO_PUT) << ", perpetual calls: " << book.Count(BOOK_PAO_CALL) << ", perpetual puts: " << book.Count(BOOK_PAO_PUT) << endl;
+	std::cout << "Position:" << '\t' << "Type:" << '\t' << "Option::Price:" << '\t' << "OptionBook::Price:" << '\t' << "Delta:" << '\t' << '\t' << "Gamma:" << endl;
+
+	for (int i = 0; i < book.Count(); ++i) {
+		std::cout << i << '\t' << '\t' << book_options[i]->OptionType() << '\t' << book_options[i]->Price(book_spots[i]) << '\t' << '\t' << book_prices[i] << '\t' << '\t' << '\t' << book_deltas[i] << '\t' << book_gammas[i] << endl;
+	}
+
+	std::cout << endl << endl << endl;
+
+	std::cout << "///////////////////////////////////////////////////////////////////////////////////////////" << endl << endl;
+
+
 	return 0;
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "Matrix.hpp"
 #include "Exception.hpp"
 #include "Greeks.hpp"
+#include "Instrumentation.hpp"
+#include "Kernels.hpp"
 #include <iostream>
 using namespace std;
 #include <vector>
@@ -16,6 +18,10 @@ using namespace std;
 
 
 
+// The number of rows of a sweep that are gathered and priced at a time
+static const int SWEEP_BLOCK = 1024;
+
+
 // The default constructor
 // Sets the size of the Vector to 0 and the style to nothing
 Vector::Vector() : m_vector(0), m_style("") {}
@@ -23,6 +29,7 @@ Vector::Vector() : m_vector(0), m_style("") {}
 
 // Parameter constructor
 // Sets the Vector's size and its private attributes from a EuropeanOption
+// The parameters are drawn from the Arena if one is given
 // 0: S (Spot price)
 // 1: K (Strike price)
 // 2: T (Expiry)
@@ -30,7 +37,7 @@ Vector::Vector() : m_vector(0), m_style("") {}
 // 4: b (Cost of carry rate)
 // 5: sig (Volatility)
 // 6: q (Dividend rate)
-Vector::Vector(double S, EuropeanOption option) : m_vector(7), m_style("EO") {
+Vector::Vector(double S, EuropeanOption option, Arena* arena) : m_vector(7, 0.0, ArenaAllocator<double>(arena)), m_style("EO") {
 	m_vector[0] = S;
 	m_vector[1] = option.StrikePrice();
 	m_vector[2] = option.Expiry();
@@ -43,6 +50,7 @@ Vector::Vector(double S, EuropeanOption option) : m_vector(7), m_style("EO") {
 
 // Parameter constructor
 // Sets the Vector's size and its private attributes from a PerpetualAmericanOption
+// The parameters are drawn from the Arena if one is given
 // 0: S (Spot price)
 // 1: K (Strike price)
 // 2: T (Expiry)
@@ -50,7 +58,7 @@ Vector::Vector(double S, EuropeanOption option) : m_vector(7), m_style("EO") {
 // 4: b (Cost of carry rate)
 // 5: sig (Volatility)
 // 6: q (Dividend rate)
-Vector::Vector(double S, PerpetualAmericanOption option) : m_vector(6), m_style("PAO") {
+Vector::Vector(double S, PerpetualAmericanOption option, Arena* arena) : m_vector(6, 0.0, ArenaAllocator<double>(arena)), m_style("PAO") {
 	m_vector[0] = S;
 	m_vector[1] = option.StrikePrice();
 	m_vector[2] = option.RiskFreeRate();
@@ -65,7 +73,12 @@ Vector::~Vector() {}
 
 
 // Copy constructor
-Vector::Vector(const Vector& source) : m_vector(source.m_vector), m_style(source.m_style) {}
+// The parameters are copied onto the global heap, not into the Arena of the source
+Vector::Vector(const Vector& source) : m_vector(source.m_vector.begin(), source.m_vector.end()), m_style(source.m_style) {}
+
+
+// Copy constructor into an Arena
+Vector::Vector(const Vector& source, Arena* arena) : m_vector(source.m_vector.begin(), source.m_vector.end(), ArenaAllocator<double>(arena)), m_style(source.m_style) {}
 
 
 // Assignment operator
@@ -94,6 +107,16 @@ double& Vector::operator [] (int index) {
 }
 
 
+// []-operator for a const Vector
+// Throws an OutOfBoundsException if the index is out of bounds
+double Vector::operator [] (int index) const {
+
+	if (index < 0 || index >= m_vector.size()) throw OutOfBoundsException(index);
+
+	return m_vector[index];
+}
+
+
 // Returns the size of the vector
 int Vector::Size() const {
 	return m_vector.size();
@@ -101,7 +124,7 @@ int Vector::Size() const {
 
 
 // Returns the option style
-std::string Vector::OptionStyle() {
+std::string Vector::OptionStyle() const {
 	return m_style;
 }
 
@@ -130,7 +153,7 @@ PerpetualAmericanOption Vector::ConvertToPAO() {
 
 // Default constructor
 // Set with size 1 and a Vector of 0's
-Matrix::Matrix() : m_matrix(1) {
+Matrix::Matrix() : m_matrix(1), m_index(-1) {
 	m_matrix.push_back(Vector());
 }
 
@@ -140,10 +163,16 @@ Matrix::Matrix() : m_matrix(1) {
 // index: the parameter of the option that is being incremented
 // b: the ending point of the increments
 // n: the size of the matrix
-Matrix::Matrix(EuropeanOption EO, double S, int index, double b, double n) : m_matrix() {
+// arena: the Arena that the rows are drawn from, or null for the global heap
+Matrix::Matrix(EuropeanOption EO, double S, int index, double b, double n, Arena* arena) : m_matrix(ArenaAllocator<Vector>(arena)), m_index(index) {
+
+	PROBE(PROBE_MATRIX);
+
+	// Reserve every row up front so that no rows are copied while the Matrix grows
+	m_matrix.reserve(int(n) + 1);
 
 	// Initialize a Vector
-	Vector v(S, EO);
+	Vector v(S, EO, arena);
 
 	// Initialize a as the indexed parameter from the Vector
 	double a = v[index];
@@ -152,7 +181,7 @@ Matrix::Matrix(EuropeanOption EO, double S, int index, double b, double n) : m_m
 	double h = (b - a) / n;
 
 	// Insert v as the first row of the Matrix
-	m_matrix.push_back(v);
+	m_matrix.emplace_back(v, arena);
 
 	// Loop through the intended size of the Matrix
 	for (int i = 0; i < n; ++i) {
@@ -165,8 +194,8 @@ Matrix::Matrix(EuropeanOption EO, double S, int index, double b, double n) : m_m
 			}
 		}
 
-		// Add the updated Vector to the next row of the Matrix
-		m_matrix.push_back(v);
+		// Add the updated Vector to the next row of the Matrix, built in place in the Arena of the Matrix
+		m_matrix.emplace_back(v, arena);
 	}
 }
 
@@ -176,10 +205,16 @@ Matrix::Matrix(EuropeanOption EO, double S, int index, double b, double n) : m_m
 // index: the parameter of the option that is being incremented
 // b: the ending point of the increments
 // n: the size of the matrix
-Matrix::Matrix(PerpetualAmericanOption PAO, double S, int index, double b, double n) : m_matrix() {
+// arena: the Arena that the rows are drawn from, or null for the global heap
+Matrix::Matrix(PerpetualAmericanOption PAO, double S, int index, double b, double n, Arena* arena) : m_matrix(ArenaAllocator<Vector>(arena)), m_index(index) {
+
+	PROBE(PROBE_MATRIX);
+
+	// Reserve every row up front so that no rows are copied while the Matrix grows
+	m_matrix.reserve(int(n) + 1);
 
 	// Initialize a Vector
-	Vector v(S, PAO);
+	Vector v(S, PAO, arena);
 
 	// Initialize a as the indexed parameter from the Vector
 	double a = v[index];
@@ -188,7 +223,7 @@ Matrix::Matrix(PerpetualAmericanOption PAO, double S, int index, double b, doubl
 	double h = (b - a) / n;
 
 	// Insert v as the first row of the Matrix
-	m_matrix.push_back(v);
+	m_matrix.emplace_back(v, arena);
 
 	// Loop through the intended size of the Matrix
 	for (int i = 0; i < n; ++i) {
@@ -201,18 +236,23 @@ Matrix::Matrix(PerpetualAmericanOption PAO, double S, int index, double b, doubl
 			}
 		}
 
-		// Add the updated Vector to the next row of the Matrix
-		m_matrix.push_back(v);
+		// Add the updated Vector to the next row of the Matrix, built in place in the Arena of the Matrix
+		m_matrix.emplace_back(v, arena);
 	}
 }
 
 
+// Parameter constructor from a set of rows
+Matrix::Matrix(const std::vector<Vector>& rows) : m_matrix(rows.begin(), rows.end()), m_index(-1) {}
+
+
 // Destructor
 Matrix::~Matrix() {}
 
 
 // Copy constructor
-Matrix::Matrix(const Matrix& source) : m_matrix(source.m_matrix) {}
+// The rows are copied onto the global heap, so the copy stays valid after the Arena of the source is Reset()
+Matrix::Matrix(const Matrix& source) : m_matrix(source.m_matrix.begin(), source.m_matrix.end()), m_index(source.m_index) {}
 
 
 // Assignment operator
@@ -225,6 +265,7 @@ Matrix& Matrix::operator = (const Matrix& source) {
 	m_matrix.clear();
 
 	m_matrix = source.m_matrix;
+	m_index = source.m_index;
 
 	return *this;
 }
@@ -234,9 +275,22 @@ Matrix& Matrix::operator = (const Matrix& source) {
 // Throws an OutOfBoundsException if the index is out of bounds
 Vector& Matrix::operator [] (int index) {
 
-	if (this->GetRow(0).OptionStyle() == "EO" && index > 6 || index < 0) throw OutOfBoundsException(index);
+	if (m_matrix[0].OptionStyle() == "EO" && index > 6 || index < 0) throw OutOfBoundsException(index);
+
+	else if (m_matrix[0].OptionStyle() == "PAO" && index > 5 || index < 0) throw OutOfBoundsException(index);
 
-	else if (this->GetRow(0).OptionStyle() == "PAO" && index > 5 || index < 0) throw OutOfBoundsException(index);
+	// The row may be changed through the reference, so the Matrix can no longer be priced as a sweep
+	m_index = -1;
+
+	return m_matrix[index];
+}
+
+
+// []-operator for a const Matrix
+// Throws an OutOfBoundsException if the index is out of bounds
+const Vector& Matrix::operator [] (int index) const {
+
+	if (index < 0 || index >= m_matrix.size()) throw OutOfBoundsException(index);
 
 	return m_matrix[index];
 }
@@ -256,12 +310,61 @@ int Matrix::GetSize() const {
 
 // The MatrixPricer method for Options
 // The method prices a EuropeanOption from the rows of the Matrix (Vector) and returns a tuple with a vector of calls and a vector of puts
-// If it is necessary to add another derived options class, add another else if statement that initializes that derived Option object
 boost::tuple<vector<double>, vector<double>> Matrix::MatrixPricer() {
 
 	// Initialize 2 vectors: one for the call prices and one for the put prices
-	vector<double> calls;
-	vector<double> puts;
+	vector<double> calls(m_matrix.size());
+	vector<double> puts(m_matrix.size());
+
+	// Price into the 2 vectors
+	this->MatrixPricer(&calls[0], &puts[0]);
+
+	// Insert the 2 vectors into a tuple
+	boost::tuple<vector<double>, vector<double>> tup(calls, puts);
+
+	// Return the tuple
+	return tup;
+}
+
+
+
+// The MatrixPricer method for Options that writes into caller-provided buffers
+// Both buffers must hold one entry per row of the Matrix
+// A sweep of EuropeanOptions gathers its swept column and goes through the sweep kernel of its index, and any other Matrix through the option classes
+void Matrix::MatrixPricer(double* calls, double* puts) {
+
+	PROBE(PROBE_MATRIX_PRICER);
+
+	if (m_index >= 0 && m_matrix[0].OptionStyle() == "EO") {
+
+		const Vector& first = m_matrix[0];
+		double base[6] = { first[0], first[1], first[2], first[3], first[4], first[5] };
+
+		// The varying column is gathered a block at a time into the stack so that pricing does not allocate
+		double values[SWEEP_BLOCK];
+
+		for (int offset = 0; offset < m_matrix.size(); offset += SWEEP_BLOCK) {
+
+			int m = min(SWEEP_BLOCK, int(m_matrix.size()) - offset);
+
+			for (int k = 0; k < m; ++k) {
+				values[k] = m_matrix[offset + k][m_index];
+			}
+
+			SweepBatch(m, m_index, base, values, calls + offset, puts + offset);
+		}
+
+		return;
+	}
+
+	this->GenericPricer(calls, puts);
+}
+
+
+
+// Prices every row with the option classes
+// If it is necessary to add another derived options class, add another else if statement that initializes that derived Option object
+void Matrix::GenericPricer(double* calls, double* puts) {
 
 	// If the option type of the first vector is a EuropeanOption, proceed in the if block
 	if (m_matrix[0].OptionStyle() == "EO") {
@@ -275,14 +378,14 @@ boost::tuple<vector<double>, vector<double>> Matrix::MatrixPricer() {
 			// Assign the EuropeanOption that is obtained from the Matrix's row (Vector)
 			option = m_matrix[i].ConvertToEO();
 
-			// Push back the 2 vector with the option prices calculated from each of the Matrix's row vectors
+			// Fill the 2 buffers with the option prices calculated from each of the Matrix's row vectors
 
-			calls.push_back(option.Price(m_matrix[i][0]));
+			calls[i] = option.Price(m_matrix[i][0]);
 
 			// Change the EuropeanOption from a call to a put
 			option.Toggle();
 
-			puts.push_back(option.Price(m_matrix[i][0]));
+			puts[i] = option.Price(m_matrix[i][0]);
 
 		}
 	}
@@ -299,31 +402,25 @@ boost::tuple<vector<double>, vector<double>> Matrix::MatrixPricer() {
 			// Assign the AmericanOption that is obtained from the Matrix's row (Vector)
 			option = m_matrix[i].ConvertToPAO();
 
-			// Push back the 2 vector with the option prices calculated from each of m's row vectors
+			// Fill the 2 buffers with the option prices calculated from each of m's row vectors
 
-			calls.push_back(option.Price(m_matrix[i][0]));
+			calls[i] = option.Price(m_matrix[i][0]);
 
 			// Change the PerpetualAmericanOption from a call to a put
 			option.Toggle();
 
-			puts.push_back(option.Price(m_matrix[i][0]));
+			puts[i] = option.Price(m_matrix[i][0]);
 
 		}
 	}
 
-	// If the option type is neither of the two option, set the two vectors as 0 vectors
+	// If the option type is neither of the two option, set the two buffers to 0
 	else {
 		for (int i = 0; i < m_matrix.size(); ++i) {
-			calls.push_back(0);
-			puts.push_back(0);
+			calls[i] = 0;
+			puts[i] = 0;
 		}
 	}
-
-	// Insert the 2 vectors into a tuple
-	boost::tuple<vector<double>, vector<double>> tup(calls, puts);
-
-	// Return the tuple
-	return tup;
 }
 
 
@@ -334,11 +431,29 @@ boost::tuple<vector<double>, vector<double>> Matrix::MatrixPricer() {
 boost::tuple<vector<double>, vector<double>, vector<double>> Matrix::MatrixPricer(Greeks g) {
 
 	// Initialize 3 vectors: one for the delta call prices, one for the delta put prices, and one for the gammas
-	vector<double> delta_calls;
-	vector<double> delta_puts;
-	vector<double> gamma;
+	vector<double> delta_calls(m_matrix.size());
+	vector<double> delta_puts(m_matrix.size());
+	vector<double> gamma(m_matrix.size());
+
+	// Calculate into the 3 vectors
+	this->MatrixPricer(g, &delta_calls[0], &delta_puts[0], &gamma[0]);
 
-	// Initialize a EuropeanOption and a Greek
+	// Insert the 3 vectors into a tuple
+	boost::tuple<vector<double>, vector<double>, vector<double>> tup(delta_calls, delta_puts, gamma);
+
+	// Return the tuple
+	return tup;
+}
+
+
+
+// The MatrixPricer method for the Greeks that writes into caller-provided buffers
+// The 3 buffers must hold one entry per row of the Matrix
+void Matrix::MatrixPricer(const Greeks&, double* delta_calls, double* delta_puts, double* gamma) {
+
+	PROBE(PROBE_MATRIX_PRICER);
+
+	// Initialize a EuropeanOption
 	EuropeanOption EO;
 
 	// Loop through the total number of rows of matrix m
@@ -346,24 +461,18 @@ boost::tuple<vector<double>, vector<double>, vector<double>> Matrix::MatrixPrice
 
 		EO = m_matrix[i].ConvertToEO();
 
-		// Push back the 3 vector with the deltas and gamma calculated from each of m's row vectors
+		// Fill the 3 buffers with the deltas and gamma calculated from each of m's row vectors
 
-		delta_calls.push_back(EO.Delta(m_matrix[i][0]));
+		delta_calls[i] = EO.Delta(m_matrix[i][0]);
 
 		// Change the EuropeanOption from a call to a put
 		EO.Toggle();
 
-		delta_puts.push_back(EO.Delta(m_matrix[i][0]));
+		delta_puts[i] = EO.Delta(m_matrix[i][0]);
 
-		gamma.push_back(EO.Gamma(m_matrix[i][0]));
+		gamma[i] = EO.Gamma(m_matrix[i][0]);
 
 	}
-
-	// Insert the 3 vectors into a tuple
-	boost::tuple<vector<double>, vector<double>, vector<double>> tup(delta_calls, delta_puts, gamma);
-
-	// Return the tuple
-	return tup;
 }
 
 
@@ -371,9 +480,11 @@ boost::tuple<vector<double>, vector<double>, vector<double>> Matrix::MatrixPrice
 // Outputs the matrix
 void Matrix::OutputMatrix(const double& n) {
 
+	PROBE(PROBE_OUTPUT);
+
 	for (int i = 0; i < n; ++i) {
 
-		for (int j = 0; j < this->GetRow(0).Size(); ++j) {
+		for (int j = 0; j < m_matrix[0].Size(); ++j) {
 
 			std::cout << m_matrix[i][j] << " ";
 		}
@@ -406,7 +517,9 @@ void Matrix::ReadChange(Greeks g, const int& n) {
 
 
 // Create a global function to read through the option pricing MatrixPricer tuple without overlap in the main function
-void ReadTuple(boost::tuple<vector<double>, vector<double>> tup, const double& n) {
+void ReadTuple(const boost::tuple<vector<double>, vector<double>>& tup, const double& n) {
+
+	PROBE(PROBE_OUTPUT);
 
 	// Output the first vector (calls) of the tuple
 	std::cout << "Call Prices: " << endl;
@@ -428,7 +541,9 @@ void ReadTuple(boost::tuple<vector<double>, vector<double>> tup, const double& n
 
 
 // Create a global function to read through the greek calculating MatrixPricer tuple without overlap in the main function
-void ReadTuple(boost::tuple<vector<double>, vector<double>, vector<double>> tup, const double& n) {
+void ReadTuple(const boost::tuple<vector<double>, vector<double>, vector<double>>& tup, const double& n) {
+
+	PROBE(PROBE_OUTPUT);
 
 	// Output the first vector (delta calls) of the tuple
 	std::cout << "Call Deltas: " << endl;
@@ -9,6 +9,7 @@
 #include "EuropeanOption.hpp"
 #include "PerpetualAmericanOption.hpp"
 #include "Greeks.hpp"
+#include "Arena.hpp"
 #include <iostream>
 using namespace std;
 #include <vector>
@@ -24,8 +25,9 @@ private:
 
 	// The private attributes are a vector of doubles that hold the option parameter and a string that indicates the style of option
 	// If it is necessary to add another derived options class, another parameter constructor should be added and a string should be chosen to represent that option
+	// The parameters are drawn from an Arena when the Vector is given one, and from the global heap otherwise
 
-	std::vector<double> m_vector;
+	std::vector<double, ArenaAllocator<double>> m_vector;
 	std::string m_style;
 
 public:
@@ -34,23 +36,30 @@ public:
 	Vector();
 
 	// Parameter constructor for a EuropeanOption
-	Vector(double S, EuropeanOption option);
+	Vector(double S, EuropeanOption option, Arena* arena = 0);
 
 	// Parameter constructor for a PerpetualAmericanOption
-	Vector(double S, PerpetualAmericanOption option);
+	Vector(double S, PerpetualAmericanOption option, Arena* arena = 0);
 
 	// Destructor
 	virtual ~Vector();
 
 	// Copy constructor
+	// The copy is always on the global heap, so it stays valid after the Arena of the source is Reset()
 	Vector(const Vector& source);
 
+	// Copy constructor that draws the copy from an Arena, or from the global heap if arena is null
+	Vector(const Vector& source, Arena* arena);
+
 	// Assignment operator
 	Vector& operator = (const Vector& source);
 
 	// [] operator
 	double& operator [] (int index);
 
+	// [] operator for a const Vector
+	double operator [] (int index) const;
+
 	// Returns the size of the vector
 	int Size() const;
 
@@ -61,7 +70,7 @@ public:
 	PerpetualAmericanOption ConvertToPAO();
 
 	// Outputs the option type
-	std::string OptionStyle();
+	std::string OptionStyle() const;
 
 };
 
@@ -75,7 +84,16 @@ private:
 
 	// The private attribute is a vector of the Vector class
 	// A Matrix object will be nx7 matrix
-	std::vector<Vector> m_matrix;
+	// The rows are drawn from an Arena when the Matrix is given one, and from the global heap otherwise
+	std::vector<Vector, ArenaAllocator<Vector>> m_matrix;
+
+	// The parameter index that varies between the rows when the Matrix is a sweep built by a parameter constructor, or -1
+	// Every other parameter is the same in every row, so a sweep of EuropeanOptions is priced by the sweep kernel of its index
+	// Any access to a row through the non-const []-operator may change a row, so it sets the index back to -1
+	int m_index;
+
+	// Prices every row with the option classes
+	void GenericPricer(double* calls, double* puts);
 
 
 public:
@@ -84,15 +102,19 @@ public:
 	Matrix();
 
 	// Parameter constructor for a EuropeanOption
-	Matrix(EuropeanOption EO, double S, int index, double b, double n);
+	Matrix(EuropeanOption EO, double S, int index, double b, double n, Arena* arena = 0);
 
 	// Parameter constructor for a PerpetualAmericanOption
-	Matrix(PerpetualAmericanOption AO, double S, int index, double b, double n);
+	Matrix(PerpetualAmericanOption AO, double S, int index, double b, double n, Arena* arena = 0);
+	// A Matrix built in an Arena must not be used after Arena::Reset(), copies of it are on the global heap and may outlive the Arena
+
+	// Parameter constructor from a set of rows
+	Matrix(const std::vector<Vector>& rows);
 
 	// Destructor
 	virtual ~Matrix();
 
-	// Copy constructor
+	// Copy constructor, the copy is always on the global heap
 	Matrix(const Matrix& source);
 
 	// Assignment operator
@@ -101,6 +123,9 @@ public:
 	// []-operator
 	Vector& operator [] (int index);
 
+	// []-operator for a const Matrix
+	const Vector& operator [] (int index) const;
+
 	// Accessor to return the selected row (Vector) of the Matrix
 	Vector GetRow(const int& index);
 
@@ -113,6 +138,12 @@ public:
 	// Calculates the call/put options' deltas and gammas of a Matrix with Vectors as rows given a Greek
 	boost::tuple<vector<double>, vector<double>, vector<double>> MatrixPricer(Greeks g);
 
+	// Prices the call/put options of a Matrix into caller-provided buffers with one entry per row, such as buffers drawn from an Arena
+	void MatrixPricer(double* calls, double* puts);
+
+	// Calculates the call/put options' deltas and gammas of a Matrix into caller-provided buffers with one entry per row
+	void MatrixPricer(const Greeks& g, double* delta_calls, double* delta_puts, double* gamma);
+
 	// Outputs the total matrix
 	void OutputMatrix(const double& n);
 
@@ -125,10 +156,10 @@ public:
 
 
 // A global function that reads through the option pricing MatrixPricer tuple without overlap in the main function
-void ReadTuple(boost::tuple<vector<double>, vector<double>> tup, const double& n);
+void ReadTuple(const boost::tuple<vector<double>, vector<double>>& tup, const double& n);
 
 // A global function that reads through the greek calculating MatrixPricer tuple without overlap in the main function
-void ReadTuple(boost::tuple<vector<double>, vector<double>, vector<double>> tup, const double& n);
+void ReadTuple(const boost::tuple<vector<double>, vector<double>, vector<double>>& tup, const double& n);
 
 
 
@@ -0,0 +1,204 @@
+// Objective: Implement the OptionBook class
+
+// Include the necessary header files
+#include "OptionBook.hpp"
+#include "Exception.hpp"
+#include "Kernels.hpp"
+#include <iostream>
+using namespace std;
+#include <vector>
+#include <algorithm>
+
+
+
+// The number of options of a group that are priced into the stack and scattered at a time
+static const int BOOK_BLOCK = 256;
+
+
+
+// Prices the options [first, first + n) of a group into out with the kernel of the group
+// The switch is taken once per block, and each case is a kernel compiled for one style and side
+static void PriceGroup(const int& group, const int& first, const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* out) {
+
+	S += first; K += first; T += first; r += first; b += first; sig += first;
+
+	switch (group) {
+	case BOOK_EO_CALL: EuropeanSideBatch<true, double>(n, S, K, T, r, b, sig, out); break;
+	case BOOK_EO_PUT: EuropeanSideBatch<false, double>(n, S, K, T, r, b, sig, out); break;
+	case BOOK_PAO_CALL: PerpetualSideBatch<true, double>(n, S, K, r, b, sig, out); break;
+	case BOOK_PAO_PUT: PerpetualSideBatch<false, double>(n, S, K, r, b, sig, out); break;
+	default: break;
+	}
+}
+
+
+// Computes the deltas and gammas of the options [first, first + n) of a group with the kernel of the group
+static void GreeksGroup(const int& group, const int& first, const int& n, const double* S, const double* K, const double* T, const double* r, const double* b, const double* sig, double* delta, double* gamma) {
+
+	S += first; K += first; T += first; r += first; b += first; sig += first;
+
+	switch (group) {
+	case BOOK_EO_CALL: EuropeanSideGreeksBatch<true, double>(n, S, K, T, r, b, sig, delta, gamma); break;
+	case BOOK_EO_PUT: EuropeanSideGreeksBatch<false, double>(n, S, K, T, r, b, sig, delta, gamma); break;
+	case BOOK_PAO_CALL: PerpetualSideGreeksBatch<true, double>(n, S, K, r, b, sig, delta, gamma); break;
+	case BOOK_PAO_PUT: PerpetualSideGreeksBatch<false, double>(n, S, K, r, b, sig, delta, gamma); break;
+	default: break;
+	}
+}
+
+
+
+// Default constructor
+OptionBook::OptionBook() : m_count(0) {}
+
+
+// Parameter constructor with the records of a book
+OptionBook::OptionBook(const std::vector<OptionRecord>& records) : m_count(0) {
+
+	for (std::size_t i = 0; i < records.size(); ++i) {
+		this->Add(records[i]);
+	}
+}
+
+
+// Destructor
+OptionBook::~OptionBook() {}
+
+
+// Copy constructor
+OptionBook::OptionBook(const OptionBook& source) : m_unknown(source.m_unknown), m_count(source.m_count) {
+
+	for (int g = 0; g < BOOK_GROUPS; ++g) {
+		m_groups[g] = source.m_groups[g];
+	}
+}
+
+
+// Assignment operator
+OptionBook& OptionBook::operator = (const OptionBook& source) {
+
+	// Avoid self-assignment
+	if (this == &source) {
+		return *this;
+	}
+
+	for (int g = 0; g < BOOK_GROUPS; ++g) {
+		m_groups[g] = source.m_groups[g];
+	}
+
+	m_unknown = source.m_unknown;
+	m_count = source.m_count;
+
+	return *this;
+}
+
+
+
+// Adds a EuropeanOption with its spot price
+void OptionBook::Add(const double& S, const EuropeanOption& option) {
+	this->Add(Record(S, option));
+}
+
+
+// Adds a PerpetualAmericanOption with its spot price
+void OptionBook::Add(const double& S, const PerpetualAmericanOption& option) {
+	this->Add(Record(S, option));
+}
+
+
+// Adds a record to the group of its style and side
+void OptionBook::Add(const OptionRecord& record) {
+
+	int position = m_count++;
+
+	if (record.style != RECORD_EO && record.style != RECORD_PAO) {
+		m_unknown.push_back(position);
+		return;
+	}
+
+	Group& group = m_groups[record.style == RECORD_EO ? (record.call ? BOOK_EO_CALL : BOOK_EO_PUT) : (record.call ? BOOK_PAO_CALL : BOOK_PAO_PUT)];
+
+	group.index.push_back(position);
+	group.S.push_back(record.S);
+	group.K.push_back(record.K);
+	group.T.push_back(record.T);
+	group.r.push_back(record.r);
+	group.b.push_back(record.b);
+	group.sig.push_back(record.sig);
+}
+
+
+
+// Returns the number of options in the book
+int OptionBook::Count() const {
+	return m_count;
+}
+
+
+// Returns the number of options in one group
+int OptionBook::Count(const BookGroup& group) const {
+
+	if (group < 0 || group >= BOOK_GROUPS) throw OutOfBoundsException(group);
+
+	return m_groups[group].index.size();
+}
+
+
+
+// Prices every option in the order of the book
+// Each group is priced a block at a time into the stack, so pricing does not allocate, and the block is scattered to the positions of its options
+void OptionBook::Price(double* out) const {
+
+	double values[BOOK_BLOCK];
+
+	for (int g = 0; g < BOOK_GROUPS; ++g) {
+
+		const Group& group = m_groups[g];
+		int size = group.index.size();
+
+		for (int first = 0; first < size; first += BOOK_BLOCK) {
+
+			int n = min(BOOK_BLOCK, size - first);
+
+			PriceGroup(g, first, n, group.S.data(), group.K.data(), group.T.data(), group.r.data(), group.b.data(), group.sig.data(), values);
+
+			for (int j = 0; j < n; ++j) {
+				out[group.index[first + j]] = values[j];
+			}
+		}
+	}
+
+	for (std::size_t i = 0; i < m_unknown.size(); ++i) {
+		out[m_unknown[i]] = 0;
+	}
+}
+
+
+// Computes the delta and gamma of every option in the order of the book
+void OptionBook::Greeks(double* delta, double* gamma) const {
+
+	double deltas[BOOK_BLOCK], gammas[BOOK_BLOCK];
+
+	for (int g = 0; g < BOOK_GROUPS; ++g) {
+
+		const Group& group = m_groups[g];
+		int size = group.index.size();
+
+		for (int first = 0; first < size; first += BOOK_BLOCK) {
+
+			int n = min(BOOK_BLOCK, size - first);
+
+			GreeksGroup(g, first, n, group.S.data(), group.K.data(), group.T.data(), group.r.data(), group.b.data(), group.sig.data(), deltas, gammas);
+
+			for (int j = 0; j < n; ++j) {
+				delta[group.index[first + j]] = deltas[j];
+				gamma[group.index[first + j]] = gammas[j];
+			}
+		}
+	}
+
+	for (std::size_t i = 0; i < m_unknown.size(); ++i) {
+		delta[m_unknown[i]] = 0;
+		gamma[m_unknown[i]] = 0;
+	}
+}
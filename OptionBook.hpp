@@ -0,0 +1,93 @@
+// Objective: Create the OptionBook class, a book of mixed option styles that is priced one style and side at a time
+
+// Ensure no errors if the header file is used twice
+#ifndef OPTIONBOOK_HPP
+#define OPTIONBOOK_HPP
+
+// Include the necessary header files
+#include "EuropeanOption.hpp"
+#include "PerpetualAmericanOption.hpp"
+#include "Serialization.hpp"
+#include <iostream>
+using namespace std;
+#include <vector>
+
+
+
+// The groups of an OptionBook, one per option style and side
+enum BookGroup {
+	BOOK_EO_CALL,
+	BOOK_EO_PUT,
+	BOOK_PAO_CALL,
+	BOOK_PAO_PUT,
+	BOOK_GROUPS
+};
+
+
+// Create the OptionBook class
+// Pricing a vector of Option pointers makes a virtual call per option, and each call prices one option with branches on its side,
+// so nothing can be vectorized across the book
+// An OptionBook puts each option into the group of its style and side when it is added, and stores the groups as arrays of parameters,
+// so that Price() runs one branch-free batch kernel over each group and writes the results back in the order the options were added
+// Options are only added, so the grouping is done once and not every time the book is priced
+class OptionBook {
+private:
+
+	// The options of one group as one array per parameter, and the position of each option in the book
+	// T is unused by the PerpetualAmericanOption groups
+	struct Group {
+		std::vector<int> index;
+		std::vector<double> S;
+		std::vector<double> K;
+		std::vector<double> T;
+		std::vector<double> r;
+		std::vector<double> b;
+		std::vector<double> sig;
+	};
+
+	// The groups, and the positions of the records of an unknown style, which are given 0
+	Group m_groups[BOOK_GROUPS];
+	std::vector<int> m_unknown;
+
+	// The number of options in the book
+	int m_count;
+
+public:
+
+	// Default constructor
+	// An empty book
+	OptionBook();
+
+	// Parameter constructor with the records of a book, such as the records of a BookSnapshot
+	OptionBook(const std::vector<OptionRecord>& records);
+
+	// Destructor
+	virtual ~OptionBook();
+
+	// Copy constructor
+	OptionBook(const OptionBook& source);
+
+	// Assignment operator
+	OptionBook& operator = (const OptionBook& source);
+
+	// Add an option with its spot price, or a record, at the end of the book
+	void Add(const double& S, const EuropeanOption& option);
+	void Add(const double& S, const PerpetualAmericanOption& option);
+	void Add(const OptionRecord& record);
+
+	// Returns the number of options in the book, and in one group
+	// Throws an OutOfBoundsException if the group does not exist
+	int Count() const;
+	int Count(const BookGroup& group) const;
+
+	// Prices every option into out, which must hold Count() entries, in the order of the book
+	void Price(double* out) const;
+
+	// Computes the delta and gamma of every option into delta and gamma, which must hold Count() entries, in the order of the book
+	void Greeks(double* delta, double* gamma) const;
+
+};
+
+
+
+#endif
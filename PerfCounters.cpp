@@ -0,0 +1,150 @@
+// Objective: Implement the PerfCounters class
+
+// Include the necessary header files
+#include "PerfCounters.hpp"
+#include <iostream>
+using namespace std;
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+
+
+// The names of the events, in the order of PerfEvent
+static const char* perf_names[PERF_EVENTS] = { "cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses" };
+
+
+
+#ifdef __linux__
+
+// Opens one event for the calling thread on any CPU
+// The event is inherited by the threads that the calling thread starts afterwards, such as the workers of Scheduler::Global()
+// Returns -1 if the event cannot be opened
+static int OpenEvent(const unsigned int& type, const unsigned long long& config) {
+
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.inherit = 1;
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+#endif
+
+
+
+// Default constructor
+// Each event is opened on its own, so an event that is not supported does not disable the others
+PerfCounters::PerfCounters() {
+
+	for (int i = 0; i < PERF_EVENTS; ++i) {
+		m_fds[i] = -1;
+		m_values[i] = 0;
+	}
+
+#ifdef __linux__
+	m_fds[PERF_CYCLES] = OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+	m_fds[PERF_INSTRUCTIONS] = OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+	m_fds[PERF_BRANCH_MISSES] = OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+	m_fds[PERF_L1D_MISSES] = OpenEvent(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+	m_fds[PERF_LLC_MISSES] = OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+}
+
+
+// Destructor
+PerfCounters::~PerfCounters() {
+
+#ifdef __linux__
+	for (int i = 0; i < PERF_EVENTS; ++i) {
+		if (m_fds[i] != -1) {
+			close(m_fds[i]);
+		}
+	}
+#endif
+}
+
+
+// Resets and starts counting
+void PerfCounters::Start() {
+
+#ifdef __linux__
+	for (int i = 0; i < PERF_EVENTS; ++i) {
+		if (m_fds[i] != -1) {
+			ioctl(m_fds[i], PERF_EVENT_IOC_RESET, 0);
+			ioctl(m_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+}
+
+
+// Stops counting and reads the values
+// If the kernel multiplexed an event, its value is scaled up by the fraction of the time that it was counted
+void PerfCounters::Stop() {
+
+#ifdef __linux__
+	for (int i = 0; i < PERF_EVENTS; ++i) {
+		if (m_fds[i] != -1) {
+			ioctl(m_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+
+	for (int i = 0; i < PERF_EVENTS; ++i) {
+
+		m_values[i] = 0;
+
+		// value, time enabled, time running
+		unsigned long long data[3] = {};
+
+		if (m_fds[i] != -1 && read(m_fds[i], data, sizeof(data)) == sizeof(data) && data[2] != 0) {
+			m_values[i] = double(data[0]) * double(data[1]) / double(data[2]);
+		}
+	}
+#endif
+}
+
+
+// Returns true if the event could be opened
+bool PerfCounters::Available(const int& event) const {
+	return m_fds[event] != -1;
+}
+
+
+// Returns true if at least one event could be opened
+bool PerfCounters::Available() const {
+
+	for (int i = 0; i < PERF_EVENTS; ++i) {
+		if (m_fds[i] != -1) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+// Returns the value of an event over the last interval
+double PerfCounters::Value(const int& event) const {
+	return m_values[event];
+}
+
+
+// Returns the name of an event
+std::string PerfCounters::Name(const int& event) {
+	return perf_names[event];
+}
@@ -0,0 +1,76 @@
+// Objective: Create the PerfCounters class that reads the hardware performance counters of the calling thread and of the threads it starts
+
+// Ensure no errors if the header file is used twice
+#ifndef PERFCOUNTERS_HPP
+#define PERFCOUNTERS_HPP
+
+// Include header files
+#include <iostream>
+#include <string>
+using namespace std;
+
+
+
+// The hardware events that are counted
+// If it is necessary to count another event, add it before PERF_EVENTS and add its name and its configuration in PerfCounters.cpp
+enum PerfEvent {
+	PERF_CYCLES,
+	PERF_INSTRUCTIONS,
+	PERF_BRANCH_MISSES,
+	PERF_L1D_MISSES,
+	PERF_LLC_MISSES,
+	PERF_EVENTS
+};
+
+
+
+// Create the PerfCounters class
+// The counters are opened with perf_event_open on Linux for the calling thread and for user space only
+// The counters also count the threads started after construction, so construct them before the worker threads of a parallel workload start
+// Events that the kernel or the machine does not allow are reported as unavailable, and on other platforms every event is unavailable
+class PerfCounters {
+private:
+
+	// The file descriptor of each event, or -1 if the event is unavailable
+	int m_fds[PERF_EVENTS];
+
+	// The value of each event over the last Start()/Stop() interval, scaled for multiplexing
+	double m_values[PERF_EVENTS];
+
+	// PerfCounters own their file descriptors and cannot be copied
+	PerfCounters(const PerfCounters& source);
+	PerfCounters& operator = (const PerfCounters& source);
+
+public:
+
+	// Default constructor
+	// Opens every event
+	PerfCounters();
+
+	// Destructor
+	// Closes every event
+	virtual ~PerfCounters();
+
+	// Resets and starts counting
+	void Start();
+
+	// Stops counting and reads the values
+	void Stop();
+
+	// Returns true if the event could be opened
+	bool Available(const int& event) const;
+
+	// Returns true if at least one event could be opened
+	bool Available() const;
+
+	// Returns the value of an event over the last interval
+	double Value(const int& event) const;
+
+	// Returns the name of an event
+	static std::string Name(const int& event);
+
+};
+
+
+
+#endif
@@ -3,6 +3,9 @@
 // Include the necessary header files
 #include "Option.hpp"
 #include "PerpetualAmericanOption.hpp"
+#include "Instrumentation.hpp"
+#include "Kernels.hpp"
+#include "Exception.hpp"
 #include <iostream>
 using namespace std;
 #include <boost/math/distributions.hpp>
@@ -17,11 +20,28 @@ using namespace boost::math;
 
 
 // Default constructor
-PerpetualAmericanOption::PerpetualAmericanOption() : Option(), K(0), r(0), b(0), sig(0), q(0) {}
+PerpetualAmericanOption::PerpetualAmericanOption() : Option(), K(0), r(0), b(0), sig(0), q(0), yield_curve(), carry_curve(), pillar(-1) {}
 
 
 // Parameter constructor
-PerpetualAmericanOption::PerpetualAmericanOption(double strike, double rate, double carry, double sigma, double div) : Option(), K(strike), r(rate), b(carry), sig(sigma), q(div) {}
+PerpetualAmericanOption::PerpetualAmericanOption(double strike, double rate, double carry, double sigma, double div) : Option(), K(strike), r(rate), b(carry), sig(sigma), q(div), yield_curve(), carry_curve(), pillar(-1) {}
+
+
+// Parameter constructor that references a pillar of the curves
+// A perpetual option has no expiry, so only the rates of the pillar are used
+// The option keeps a share of each curve, so the curves stay alive while the option or any copy of it does
+// Throws an OutOfBoundsException if a curve is null or the pillar is out of bounds of either curve
+PerpetualAmericanOption::PerpetualAmericanOption(double strike, std::shared_ptr<const Curve> yield, std::shared_ptr<const Curve> carry, int index, double sigma, double div) : Option(), K(strike), r(0), b(0), sig(sigma), q(div), yield_curve(), carry_curve(), pillar(-1) {
+
+	if (!yield || !carry) throw OutOfBoundsException(index);
+
+	r = yield->Rate(index);
+	b = carry->Rate(index);
+
+	yield_curve = yield;
+	carry_curve = carry;
+	pillar = index;
+}
 
 
 // Destructor
@@ -29,7 +49,7 @@ PerpetualAmericanOption::~PerpetualAmericanOption() {}
 
 
 // Copy constructor
-PerpetualAmericanOption::PerpetualAmericanOption(const PerpetualAmericanOption& source) : Option(), K(source.K), r(source.r), b(source.b), sig(source.sig), q(source.q) {}
+PerpetualAmericanOption::PerpetualAmericanOption(const PerpetualAmericanOption& source) : Option(source), K(source.K), r(source.r), b(source.b), sig(source.sig), q(source.q), yield_curve(source.yield_curve), carry_curve(source.carry_curve), pillar(source.pillar) {}
 
 
 // Assignment operator
@@ -46,6 +66,9 @@ PerpetualAmericanOption& PerpetualAmericanOption::operator = (const PerpetualAme
 	b = source.b;
 	sig = source.sig;
 	q = source.q;
+	yield_curve = source.yield_curve;
+	carry_curve = source.carry_curve;
+	pillar = source.pillar;
 
 
 	return *this;
@@ -60,10 +83,16 @@ void PerpetualAmericanOption::StrikePrice(const double& newK) {
 
 void PerpetualAmericanOption::RiskFreeRate(const double& newr) {
 	r = newr;
+	yield_curve.reset();
+	carry_curve.reset();
+	pillar = -1;
 }
 
 void PerpetualAmericanOption::CostOfCarry(const double& newb) {
 	b = newb;
+	yield_curve.reset();
+	carry_curve.reset();
+	pillar = -1;
 }
 
 void PerpetualAmericanOption::Volatility(const double& newsig) {
@@ -81,11 +110,22 @@ double PerpetualAmericanOption::StrikePrice() const {
 	return K;
 }
 
+// The rates of an option that references its curves are read from the curves, the same as for a EuropeanOption
 double PerpetualAmericanOption::RiskFreeRate() const {
+
+	if (yield_curve) {
+		return yield_curve->Rate(pillar);
+	}
+
 	return r;
 }
 
 double PerpetualAmericanOption::CostOfCarry() const {
+
+	if (carry_curve) {
+		return carry_curve->Rate(pillar);
+	}
+
 	return b;
 }
 
@@ -97,6 +137,10 @@ double PerpetualAmericanOption::Dividend() const {
 	return q;
 }
 
+int PerpetualAmericanOption::Pillar() const {
+	return pillar;
+}
+
 
 
 // Accessor for all the private attributes
@@ -104,7 +148,7 @@ std::string PerpetualAmericanOption::Description() const {
 
 	std::stringstream ss;
 
-	ss << " " << K << " " << r << " " << b << " " << sig << " " << q << " " << Option::OptionType() << endl;
+	ss << " " << K << " " << this->RiskFreeRate() << " " << this->CostOfCarry() << " " << sig << " " << q << " " << Option::OptionType() << endl;
 
 	return ss.str();
 }
@@ -112,39 +156,18 @@ std::string PerpetualAmericanOption::Description() const {
 
 
 // Prices the PerpetualAmericanOption
+// Uses the double precision kernels
 double PerpetualAmericanOption::Price(const double& S) const {
 
-	double sig2 = sig * sig;
-	double fac = b / sig2 - 0.5;
-	fac *= fac;
-
+	PROBE(PROBE_PRICE);
 
 	// If the option type is a call, compute for a call
 	if (Option::OptionType() == "Call") {
-
-
-		double y1 = 0.5 - b / sig2 + sqrt(fac + 2.0 * r / sig2);
-
-
-		if (1.0 == y1)
-			return S;
-
-		double fac2 = ((y1 - 1.0) * S) / (y1 * K);
-		double c = K * pow(fac2, y1) / (y1 - 1.0);
-		return c;
+		return PerpetualCall<double>(S, K, this->RiskFreeRate(), this->CostOfCarry(), sig);
 	}
 
 	// Otherwise, the option type is a put and compute for a put
-
-	double y2 = 0.5 - b / sig2 - sqrt(fac + 2.0 * r / sig2);
-
-	if (0.0 == y2)
-		return S;
-
-	double fac2 = ((y2 - 1.0) * S) / (y2 * K);
-	double p = K * pow(fac2, y2) / (1.0 - y2);
-
-	return p;
+	return PerpetualPut<double>(S, K, this->RiskFreeRate(), this->CostOfCarry(), sig);
 }
 
 
@@ -6,8 +6,10 @@
 
 // Include header files
 #include "Option.hpp"
+#include "Curve.hpp"
 #include <iostream>
 #include <vector>
+#include <memory>
 using namespace std;
 #include <boost/math/distributions/normal.hpp>
 #include "boost/tuple/tuple.hpp"
@@ -37,6 +39,12 @@ private:
 	// Dividend rate
 	double q;
 
+	// The yield curve, the cost of carry curve, and the pillar the option takes its rates from
+	// The curves are shared with the caller and with every copy of the option, and are null when the option uses its flat r and b
+	std::shared_ptr<const Curve> yield_curve;
+	std::shared_ptr<const Curve> carry_curve;
+	int pillar;
+
 public:
 
 	// Default constructor
@@ -45,6 +53,11 @@ public:
 	// Parameter constructor
 	PerpetualAmericanOption(double K, double r, double b, double sig, double q);
 
+	// Parameter constructor that references a pillar of a yield curve and a cost of carry curve
+	// r and b are read from the curves every time they are used, as for a EuropeanOption, so changes of the curves' rates are seen by the option
+	// Throws an OutOfBoundsException if a curve is null or the pillar is out of bounds of either curve
+	PerpetualAmericanOption(double K, std::shared_ptr<const Curve> yield, std::shared_ptr<const Curve> carry, int pillar, double sig, double q);
+
 	// Destructor
 	virtual ~PerpetualAmericanOption();
 
@@ -55,6 +68,7 @@ public:
 	PerpetualAmericanOption& operator = (const PerpetualAmericanOption& source);
 
 	// Modifiers for the private attributes
+	// Changing r or b stops the option from referencing its curves
 	void StrikePrice(const double& K);
 	void RiskFreeRate(const double& r);
 	void CostOfCarry(const double& b);
@@ -62,12 +76,16 @@ public:
 	void Dividend(const double& q);
 
 	// Accessors for the private attributes
+	// RiskFreeRate and CostOfCarry return the rates of the pillar when the option references its curves
 	double StrikePrice() const;
 	double RiskFreeRate() const;
 	double CostOfCarry() const;
 	double Volatility() const;
 	double Dividend() const;
 
+	// Accessor for the referenced pillar, -1 if the option does not reference a curve
+	int Pillar() const;
+
 	// Accessor for all private attributes
 	std::string Description() const;
 
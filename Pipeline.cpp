@@ -0,0 +1,239 @@
+// Objective: Implement the Pipeline class
+
+// Include the necessary header files
+#include "Pipeline.hpp"
+#include "Coroutines.hpp"
+#include "Serialization.hpp"
+#include "Curve.hpp"
+#include "Exception.hpp"
+#include <iostream>
+using namespace std;
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+
+
+
+// Closes the Channels around a stage when the stage ends, whether it returns or throws
+// Closing the input as well stops the stages upstream when a stage downstream has failed
+struct CloseOnExit {
+	Channel<PipelineBatch>* in;
+	Channel<PipelineBatch>* out;
+	std::atomic<int>* live;
+
+	~CloseOnExit() {
+
+		if (in != 0) in->Close();
+
+		if (out != 0 && (live == 0 || --*live == 0)) out->Close();
+	}
+};
+
+
+
+// Default constructor
+Pipeline::Pipeline() : m_yield(std::vector<double>(1, 1.0), std::vector<double>(1, 0.08)), m_carry(std::vector<double>(1, 1.0), std::vector<double>(1, 0.08)),
+	m_batch(256), m_depth(4), m_pricers(max(1, int(std::thread::hardware_concurrency()))) {}
+
+
+// Parameter constructor
+Pipeline::Pipeline(const Curve& yield, const Curve& carry, int batch, int depth, int pricers) : m_yield(yield), m_carry(carry), m_batch(max(1, batch)), m_depth(max(1, depth)), m_pricers(max(1, pricers)) {}
+
+
+// Destructor
+Pipeline::~Pipeline() {}
+
+
+// Copy constructor
+Pipeline::Pipeline(const Pipeline& source) : m_yield(source.m_yield), m_carry(source.m_carry), m_batch(source.m_batch), m_depth(source.m_depth), m_pricers(source.m_pricers) {}
+
+
+// Assignment operator
+Pipeline& Pipeline::operator = (const Pipeline& source) {
+
+	if (this == &source) {
+		return *this;
+	}
+
+	m_yield = source.m_yield;
+	m_carry = source.m_carry;
+	m_batch = source.m_batch;
+	m_depth = source.m_depth;
+	m_pricers = source.m_pricers;
+
+	return *this;
+}
+
+
+// Runs the stages until the input is exhausted
+// The Executors are stopped before the Channels go out of scope, so no stage can touch a Channel after Run returns
+int Pipeline::Run(std::istream& is, std::ostream& os) {
+
+	Executor io(1);
+	Executor compute(m_pricers);
+
+	Channel<PipelineBatch> read(m_depth), looked_up(m_depth), priced(m_depth);
+	std::atomic<int> live(m_pricers);
+	int written = 0;
+
+	TaskGroup group;
+
+	this->Read(is, read, io).Start(io, group);
+	this->LookUp(read, looked_up, io).Start(io, group);
+
+	for (int i = 0; i < m_pricers; ++i) {
+		this->Price(looked_up, priced, compute, live).Start(compute, group);
+	}
+
+	this->Write(priced, os, io, written).Start(io, group);
+
+	try {
+		group.Wait();
+	}
+	catch (...) {
+		io.Stop();
+		compute.Stop();
+		throw;
+	}
+
+	io.Stop();
+	compute.Stop();
+
+	return written;
+}
+
+
+// Reads batches of m_batch options
+// Throws a SerializationException for a line that is not an option
+Task Pipeline::Read(std::istream& is, Channel<PipelineBatch>& out, Executor& io) {
+
+	CloseOnExit guard = { 0, &out, 0 };
+
+	std::string line;
+	int index = 0, first = 0, number = 0;
+
+	PipelineBatch batch = {};
+	batch.index = index;
+	batch.first = first;
+
+	while (std::getline(is, line)) {
+
+		++number;
+
+		if (line.empty()) continue;
+
+		std::stringstream fields(line);
+		std::string style;
+		OptionRecord rec = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+		fields >> style >> rec.call >> rec.S >> rec.K;
+
+		if (style == "EO") {
+			rec.style = RECORD_EO;
+			fields >> rec.T;
+		}
+
+		else if (style == "PAO") {
+			rec.style = RECORD_PAO;
+		}
+
+		fields >> rec.sig >> rec.q;
+
+		if (!fields || rec.style == 0) throw SerializationException("line " + std::to_string(number) + " is not an option");
+
+		batch.records.push_back(rec);
+
+		if (int(batch.records.size()) == m_batch) {
+
+			if (!co_await out.Push(std::move(batch), io)) co_return;
+
+			first += m_batch;
+
+			batch = PipelineBatch();
+			batch.index = ++index;
+			batch.first = first;
+		}
+	}
+
+	if (!batch.records.empty()) {
+		co_await out.Push(std::move(batch), io);
+	}
+}
+
+
+// Fills in r and b from the curves at the expiry of each option
+// A PerpetualAmericanOption uses the rates of the longest pillar
+Task Pipeline::LookUp(Channel<PipelineBatch>& in, Channel<PipelineBatch>& out, Executor& io) {
+
+	CloseOnExit guard = { &in, &out, 0 };
+
+	while (std::optional<PipelineBatch> batch = co_await in.Pop(io)) {
+
+		for (std::size_t i = 0; i < batch->records.size(); ++i) {
+
+			OptionRecord& rec = batch->records[i];
+			double T = rec.style == RECORD_PAO ? HUGE_VAL : rec.T;
+
+			rec.r = m_yield.RateAt(T);
+			rec.b = m_carry.RateAt(T);
+		}
+
+		if (!co_await out.Push(std::move(*batch), io)) co_return;
+	}
+}
+
+
+// Prices batches
+// The last Price coroutine to finish closes the output
+Task Pipeline::Price(Channel<PipelineBatch>& in, Channel<PipelineBatch>& out, Executor& compute, std::atomic<int>& live) {
+
+	CloseOnExit guard = { &in, &out, &live };
+
+	while (std::optional<PipelineBatch> batch = co_await in.Pop(compute)) {
+
+		int n = batch->records.size();
+
+		batch->price.resize(n);
+		batch->delta.resize(n);
+		batch->gamma.resize(n);
+
+		PriceRecords(n, &batch->records[0], &batch->price[0]);
+		GreeksRecords(n, &batch->records[0], &batch->delta[0], &batch->gamma[0]);
+
+		if (!co_await out.Push(std::move(*batch), compute)) co_return;
+	}
+}
+
+
+// Writes the batches in the order of the input
+// A batch that arrives before the ones ahead of it is held until they have been written
+Task Pipeline::Write(Channel<PipelineBatch>& in, std::ostream& os, Executor& io, int& written) {
+
+	CloseOnExit guard = { &in, 0, 0 };
+
+	std::map<int, PipelineBatch> held;
+	int next = 0;
+
+	while (std::optional<PipelineBatch> batch = co_await in.Pop(io)) {
+
+		int index = batch->index;
+		held[index] = std::move(*batch);
+
+		while (!held.empty() && held.begin()->first == next) {
+
+			PipelineBatch& ready = held.begin()->second;
+
+			for (std::size_t i = 0; i < ready.records.size(); ++i) {
+				os << ready.first + i << ',' << ready.price[i] << ',' << ready.delta[i] << ',' << ready.gamma[i] << '\n';
+			}
+
+			written += ready.records.size();
+
+			held.erase(held.begin());
+			++next;
+		}
+	}
+}
@@ -0,0 +1,85 @@
+// Objective: Create the Pipeline class that reads, looks up market data for, prices, and writes batches of options with coroutines
+
+// Ensure no errors if the header file is used twice
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+// Include header files
+#include "Coroutines.hpp"
+#include "Serialization.hpp"
+#include "Curve.hpp"
+#include <iostream>
+#include <vector>
+#include <atomic>
+using namespace std;
+
+
+
+// Create the PipelineBatch struct
+// A batch of options that moves through the stages, with its position in the input so the output keeps the input order
+struct PipelineBatch {
+	int index;
+	int first;
+	std::vector<OptionRecord> records;
+	std::vector<double> price;
+	std::vector<double> delta;
+	std::vector<double> gamma;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the Pipeline class
+// The stages are coroutines connected by Channels of m_depth batches:
+// Read parses batches of options from a text stream, LookUp fills in r and b from the yield and cost of carry curves,
+// m_pricers Price coroutines compute the prices, deltas, and gammas, and Write outputs one line per option
+// Read, LookUp, and Write run on one I/O thread and Price runs on its own threads, so the pricing threads never block on a stream
+// At most m_depth batches wait in each Channel and Write holds back at most m_pricers + m_depth batches to restore the order,
+// so the memory of a run does not grow with the size of the input
+// The input has one option per line: "EO call S K T sig q" or "PAO call S K sig q", where call is 1 for a call and 0 for a put
+// The output has one line per option: "index,price,delta,gamma"
+class Pipeline {
+private:
+
+	// The market data
+	Curve m_yield;
+	Curve m_carry;
+
+	// The number of options per batch, the depth of the Channels, and the number of pricing threads
+	int m_batch;
+	int m_depth;
+	int m_pricers;
+
+	// The stages
+	Task Read(std::istream& is, Channel<PipelineBatch>& out, Executor& io);
+	Task LookUp(Channel<PipelineBatch>& in, Channel<PipelineBatch>& out, Executor& io);
+	Task Price(Channel<PipelineBatch>& in, Channel<PipelineBatch>& out, Executor& compute, std::atomic<int>& live);
+	Task Write(Channel<PipelineBatch>& in, std::ostream& os, Executor& io, int& written);
+
+public:
+
+	// Default constructor
+	// Flat 8% curves, with batches of 256 options, Channels of 4 batches, and one pricing thread per hardware thread
+	Pipeline();
+
+	// Parameter constructor with the market data, the number of options per batch, the depth of the Channels, and the number of pricing threads
+	Pipeline(const Curve& yield, const Curve& carry, int batch, int depth, int pricers);
+
+	// Destructor
+	virtual ~Pipeline();
+
+	// Copy constructor
+	Pipeline(const Pipeline& source);
+
+	// Assignment operator
+	Pipeline& operator = (const Pipeline& source);
+
+	// Runs the stages until the input is exhausted and returns the number of options written
+	// Throws the first exception of a stage, such as a SerializationException for a line that cannot be read
+	int Run(std::istream& is, std::ostream& os);
+
+};
+
+
+
+#endif
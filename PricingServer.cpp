@@ -0,0 +1,685 @@
+// Objective: Implement the PricingServer class
+
+// Include the necessary header files
+#include "PricingServer.hpp"
+#include "Serialization.hpp"
+#include "Exception.hpp"
+#include <iostream>
+using namespace std;
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#endif
+
+
+
+// The epoll ids of the listening socket and of the eventfd
+// The connections are numbered from 2
+static const unsigned long long LISTEN_ID = 0;
+static const unsigned long long WAKE_ID = 1;
+
+
+// Returns the number of values in the response to a request
+int ResponseValues(const unsigned int& op, const unsigned int& count) {
+	return op == OP_GREEKS ? 3 * count : count;
+}
+
+
+#ifdef __linux__
+
+// Fills a Unix or TCP socket address and returns its length
+static socklen_t SocketAddress(const std::string& address, sockaddr_storage& storage) {
+
+	std::memset(&storage, 0, sizeof(storage));
+
+	if (!address.empty() && address[0] == '/') {
+
+		sockaddr_un* un = reinterpret_cast<sockaddr_un*>(&storage);
+
+		if (address.size() >= sizeof(un->sun_path)) throw SocketException("the socket path " + address + " is too long");
+
+		un->sun_family = AF_UNIX;
+		std::strcpy(un->sun_path, address.c_str());
+
+		return sizeof(sockaddr_un);
+	}
+
+	sockaddr_in* in = reinterpret_cast<sockaddr_in*>(&storage);
+
+	in->sin_family = AF_INET;
+	in->sin_port = htons(std::atoi(address.c_str()));
+	in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	return sizeof(sockaddr_in);
+}
+
+
+// Turns off the batching of small TCP writes, which would add up to 40 ms to each response
+static void NoDelay(const int& fd, const std::string& address) {
+
+	if (!address.empty() && address[0] == '/') return;
+
+	int one = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+
+// Connects a blocking socket to a server
+int ConnectPricingServer(const std::string& address) {
+
+	sockaddr_storage storage;
+	socklen_t length = SocketAddress(address, storage);
+
+	int fd = socket(storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+	if (fd == -1) throw SocketException("cannot create a socket");
+
+	if (connect(fd, reinterpret_cast<sockaddr*>(&storage), length) == -1) {
+		close(fd);
+		throw SocketException("cannot connect to " + address);
+	}
+
+	NoDelay(fd, address);
+
+	return fd;
+}
+
+
+// Closes a socket
+void CloseSocket(const int& fd) {
+	close(fd);
+}
+
+#else
+
+// Sockets are only implemented on Linux
+int ConnectPricingServer(const std::string& address) {
+	throw SocketException("the pricing server is only available on Linux");
+}
+
+void CloseSocket(const int& fd) {}
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Parameter constructor
+// The batches hold at least one record
+PricingServer::PricingServer(const std::string& address, int workers, int batch) : m_address(address), m_workers(max(1, workers)), m_batch(max(1, batch)),
+	m_listen(-1), m_epoll(-1), m_wake(-1), m_connections(), m_next(2), m_queue(), m_done(), m_running(false), m_requests(0), m_records(0), m_batches(0) {}
+
+
+// Destructor
+PricingServer::~PricingServer() {
+	this->Stop();
+}
+
+
+// Accessors
+std::string PricingServer::Address() const {
+	return m_address;
+}
+
+unsigned long long PricingServer::Requests() const {
+	return m_requests;
+}
+
+unsigned long long PricingServer::Records() const {
+	return m_records;
+}
+
+unsigned long long PricingServer::Batches() const {
+	return m_batches;
+}
+
+
+#ifdef __linux__
+
+// Opens the listening socket and starts the threads
+// A Unix socket path that is left over from an earlier run is removed first
+void PricingServer::Start() {
+
+	if (m_running) return;
+
+	sockaddr_storage storage;
+	socklen_t length = SocketAddress(m_address, storage);
+
+	if (storage.ss_family == AF_UNIX) {
+		unlink(m_address.c_str());
+	}
+
+	m_listen = socket(storage.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+	if (m_listen == -1) throw SocketException("cannot create a socket");
+
+	int one = 1;
+	setsockopt(m_listen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+	if (bind(m_listen, reinterpret_cast<sockaddr*>(&storage), length) == -1 || listen(m_listen, SOMAXCONN) == -1) {
+		close(m_listen);
+		m_listen = -1;
+		throw SocketException("cannot listen on " + m_address);
+	}
+
+	m_epoll = epoll_create1(EPOLL_CLOEXEC);
+	m_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	epoll_event event;
+	event.events = EPOLLIN;
+
+	event.data.u64 = LISTEN_ID;
+	epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listen, &event);
+
+	event.data.u64 = WAKE_ID;
+	epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wake, &event);
+
+	m_running = true;
+
+	for (int i = 0; i < m_workers; ++i) {
+		m_pool.push_back(std::thread(&PricingServer::Work, this));
+	}
+
+	m_loop = std::thread(&PricingServer::Loop, this);
+}
+
+
+// Stops the threads and closes every socket
+void PricingServer::Stop() {
+
+	if (!m_running) return;
+
+	m_running = false;
+
+	unsigned long long one = 1;
+	ssize_t n = write(m_wake, &one, sizeof(one));
+	(void)n;
+
+	m_loop.join();
+
+	{
+		std::lock_guard<std::mutex> lock(m_queue_mutex);
+		m_queue_ready.notify_all();
+	}
+
+	for (std::size_t i = 0; i < m_pool.size(); ++i) {
+		m_pool[i].join();
+	}
+
+	m_pool.clear();
+	m_queue.clear();
+	m_done.clear();
+	m_pending[0].clear();
+	m_pending[1].clear();
+
+	while (!m_connections.empty()) {
+		this->Close(m_connections.begin()->first);
+	}
+
+	close(m_wake);
+	close(m_epoll);
+	close(m_listen);
+
+	if (!m_address.empty() && m_address[0] == '/') {
+		unlink(m_address.c_str());
+	}
+
+	m_listen = m_epoll = m_wake = -1;
+}
+
+
+// The event loop
+// Every wait is followed by one dispatch, so the requests that arrived together are priced together
+void PricingServer::Loop() {
+
+	const int EVENTS = 256;
+	epoll_event events[EVENTS];
+
+	while (m_running) {
+
+		int n = epoll_wait(m_epoll, events, EVENTS, -1);
+
+		for (int i = 0; i < n; ++i) {
+
+			unsigned long long id = events[i].data.u64;
+
+			if (id == LISTEN_ID) {
+				this->Accept();
+			}
+
+			else if (id == WAKE_ID) {
+				unsigned long long count;
+				ssize_t r = read(m_wake, &count, sizeof(count));
+				(void)r;
+			}
+
+			else {
+
+				// The client is gone in both directions, so its responses could not be delivered
+				if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+					this->Close(id);
+					continue;
+				}
+
+				if (events[i].events & EPOLLIN) {
+					this->Read(id);
+				}
+
+				if (events[i].events & EPOLLOUT) {
+					this->Write(id);
+				}
+			}
+		}
+
+		this->Dispatch();
+		this->Respond();
+	}
+}
+
+
+// Accepts every pending connection
+void PricingServer::Accept() {
+
+	while (true) {
+
+		int fd = accept4(m_listen, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+		if (fd == -1) return;
+
+		NoDelay(fd, m_address);
+
+		unsigned long long id = m_next++;
+
+		Connection& connection = m_connections[id];
+		connection.fd = fd;
+		connection.written = 0;
+		connection.writing = false;
+		connection.reading = true;
+		connection.closing = false;
+		connection.jobs = 0;
+		connection.queued = 0;
+
+		epoll_event event;
+		event.events = EPOLLIN;
+		event.data.u64 = id;
+		epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event);
+	}
+}
+
+
+// Reads a connection until the socket is empty or its output is above the limit, and parses every complete request
+// The output counts the responses of the jobs that are still being priced, so a burst of requests cannot get past the limit in one read
+// At the end of the input the requests that are complete are still parsed, and Write closes the connection once they are answered
+void PricingServer::Read(const unsigned long long& id) {
+
+	std::map<unsigned long long, Connection>::iterator it = m_connections.find(id);
+
+	if (it == m_connections.end()) return;
+
+	Connection& connection = it->second;
+	char buffer[65536];
+
+	while (connection.out.size() - connection.written + connection.queued <= PRICING_OUTPUT_LIMIT) {
+
+		ssize_t n = read(connection.fd, buffer, sizeof(buffer));
+
+		if (n == 0) {
+			connection.closing = true;
+			break;
+		}
+
+		if (n == -1) {
+
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
+				this->Close(id);
+				return;
+			}
+
+			break;
+		}
+
+		connection.in.insert(connection.in.end(), buffer, buffer + n);
+
+		std::size_t used = 0;
+
+		while (connection.in.size() - used >= sizeof(PricingRequest)) {
+
+			PricingRequest request;
+			std::memcpy(&request, &connection.in[used], sizeof(request));
+
+			if (request.magic != PRICING_MAGIC || (request.op != OP_PRICE && request.op != OP_GREEKS) || request.count > PRICING_MAX_RECORDS) {
+				this->Close(id);
+				return;
+			}
+
+			std::size_t size = sizeof(PricingRequest) + request.count * sizeof(OptionRecord);
+
+			if (connection.in.size() - used < size) break;
+
+			std::shared_ptr<Job> job = std::make_shared<Job>();
+			job->connection = id;
+			job->request = request;
+			job->records.resize(request.count);
+			job->values.resize(ResponseValues(request.op, request.count));
+			job->remaining = 0;
+
+			if (request.count > 0) {
+				std::memcpy(&job->records[0], &connection.in[used + sizeof(PricingRequest)], request.count * sizeof(OptionRecord));
+			}
+
+			m_pending[request.op - 1].push_back(job);
+			++connection.jobs;
+			connection.queued += sizeof(PricingResponse) + job->values.size() * sizeof(double);
+			used += size;
+		}
+
+		connection.in.erase(connection.in.begin(), connection.in.begin() + used);
+	}
+
+	// Stop waiting for input if the connection is closing or its output is above the limit, and close the connection now if nothing is left to answer
+	this->Write(id);
+}
+
+
+// Writes as much of the output as the socket takes
+// send() with MSG_NOSIGNAL is used instead of write(), so a client that has gone away gives EPIPE instead of a SIGPIPE that ends the process
+void PricingServer::Write(const unsigned long long& id) {
+
+	std::map<unsigned long long, Connection>::iterator it = m_connections.find(id);
+
+	if (it == m_connections.end()) return;
+
+	Connection& connection = it->second;
+
+	while (connection.written < connection.out.size()) {
+
+		ssize_t n = send(connection.fd, &connection.out[connection.written], connection.out.size() - connection.written, MSG_NOSIGNAL);
+
+		if (n > 0) {
+			connection.written += n;
+			continue;
+		}
+
+		if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+
+		this->Close(id);
+		return;
+	}
+
+	bool writing = connection.written < connection.out.size();
+
+	if (!writing) {
+		connection.out.clear();
+		connection.written = 0;
+	}
+
+	// The written bytes are dropped once there are as many as the limit, so the output of a client that always lags behind does not keep growing
+	else if (connection.written >= PRICING_OUTPUT_LIMIT) {
+		connection.out.erase(connection.out.begin(), connection.out.begin() + connection.written);
+		connection.written = 0;
+	}
+
+	// A closing connection is done once every job is answered and written
+	if (connection.closing && connection.jobs == 0 && !writing) {
+		this->Close(id);
+		return;
+	}
+
+	// A closing connection no longer waits for input, since the end of its input would be reported on every wait
+	// A connection whose output is above the limit does not wait for input either, until the client has read enough of it
+	bool reading = !connection.closing && connection.out.size() - connection.written + connection.queued <= PRICING_OUTPUT_LIMIT;
+
+	if (writing != connection.writing || reading != connection.reading) {
+
+		epoll_event event;
+		event.events = (writing ? uint32_t(EPOLLOUT) : 0) | (reading ? uint32_t(EPOLLIN) : 0);
+		event.data.u64 = id;
+		epoll_ctl(m_epoll, EPOLL_CTL_MOD, connection.fd, &event);
+
+		connection.writing = writing;
+		connection.reading = reading;
+	}
+}
+
+
+// Closes a connection
+// The jobs of the connection that are still being priced are dropped when they finish
+void PricingServer::Close(const unsigned long long& id) {
+
+	std::map<unsigned long long, Connection>::iterator it = m_connections.find(id);
+
+	if (it == m_connections.end()) return;
+
+	epoll_ctl(m_epoll, EPOLL_CTL_DEL, it->second.fd, 0);
+	close(it->second.fd);
+
+	m_connections.erase(it);
+}
+
+
+// Cuts the pending jobs of each op into batches of m_batch records and hands them to the workers
+// A request with no records is answered at once
+void PricingServer::Dispatch() {
+
+	std::vector<Batch> batches;
+
+	for (int p = 0; p < 2; ++p) {
+
+		std::vector<std::shared_ptr<Job>>& pending = m_pending[p];
+
+		Batch batch;
+		batch.op = p + 1;
+		int size = 0;
+
+		for (std::size_t i = 0; i < pending.size(); ++i) {
+
+			std::shared_ptr<Job>& job = pending[i];
+			int count = job->request.count;
+
+			if (count == 0) {
+				std::lock_guard<std::mutex> lock(m_done_mutex);
+				m_done.push_back(job);
+				continue;
+			}
+
+			// Every slice is counted before any batch is handed out, so a job cannot finish while it is still being cut
+			for (int first = 0; first < count; ) {
+
+				int take = min(count - first, m_batch - size);
+
+				Slice slice = { job, first, take };
+				batch.slices.push_back(slice);
+				++job->remaining;
+
+				first += take;
+				size += take;
+
+				if (size == m_batch) {
+					batches.push_back(batch);
+					batch.slices.clear();
+					size = 0;
+				}
+			}
+		}
+
+		if (size > 0) {
+			batches.push_back(batch);
+		}
+
+		pending.clear();
+	}
+
+	if (batches.empty()) return;
+
+	m_batches += batches.size();
+
+	std::lock_guard<std::mutex> lock(m_queue_mutex);
+
+	for (std::size_t i = 0; i < batches.size(); ++i) {
+		m_queue.push_back(batches[i]);
+	}
+
+	m_queue_ready.notify_all();
+}
+
+
+// Appends the responses of the finished jobs to their connections and writes them
+void PricingServer::Respond() {
+
+	std::vector<std::shared_ptr<Job>> done;
+
+	{
+		std::lock_guard<std::mutex> lock(m_done_mutex);
+		done.swap(m_done);
+	}
+
+	std::vector<unsigned long long> touched;
+
+	for (std::size_t i = 0; i < done.size(); ++i) {
+
+		Job& job = *done[i];
+
+		std::map<unsigned long long, Connection>::iterator it = m_connections.find(job.connection);
+
+		if (it == m_connections.end()) continue;
+
+		PricingResponse response = { PRICING_MAGIC, job.request.op, job.request.count, job.request.id };
+
+		std::vector<char>& out = it->second.out;
+		const char* header = reinterpret_cast<const char*>(&response);
+		const char* values = reinterpret_cast<const char*>(job.values.data());
+
+		out.insert(out.end(), header, header + sizeof(response));
+		out.insert(out.end(), values, values + job.values.size() * sizeof(double));
+
+		--it->second.jobs;
+		it->second.queued -= sizeof(response) + job.values.size() * sizeof(double);
+		touched.push_back(job.connection);
+
+		++m_requests;
+		m_records += job.request.count;
+	}
+
+	std::sort(touched.begin(), touched.end());
+	touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+	for (std::size_t i = 0; i < touched.size(); ++i) {
+		this->Write(touched[i]);
+	}
+}
+
+
+// The worker loop
+void PricingServer::Work() {
+
+	while (true) {
+
+		Batch batch;
+
+		{
+			std::unique_lock<std::mutex> lock(m_queue_mutex);
+
+			while (m_running && m_queue.empty()) {
+				m_queue_ready.wait(lock);
+			}
+
+			if (!m_running) return;
+
+			batch = m_queue.front();
+			m_queue.pop_front();
+		}
+
+		this->Price(batch);
+	}
+}
+
+
+// Prices a batch
+// The slices are copied next to each other, priced in one call, and the values are copied back to their jobs
+// The worker that finishes the last slice of a job hands it to the event loop
+void PricingServer::Price(Batch& batch) {
+
+	std::vector<OptionRecord> records;
+
+	for (std::size_t i = 0; i < batch.slices.size(); ++i) {
+		const Slice& slice = batch.slices[i];
+		records.insert(records.end(), slice.job->records.begin() + slice.first, slice.job->records.begin() + slice.first + slice.count);
+	}
+
+	int n = records.size();
+	std::vector<double> price(n), delta, gamma;
+
+	PriceRecords(n, &records[0], &price[0]);
+
+	if (batch.op == OP_GREEKS) {
+		delta.resize(n);
+		gamma.resize(n);
+		GreeksRecords(n, &records[0], &delta[0], &gamma[0]);
+	}
+
+	bool finished = false;
+	int offset = 0;
+
+	for (std::size_t i = 0; i < batch.slices.size(); ++i) {
+
+		Slice& slice = batch.slices[i];
+		Job& job = *slice.job;
+		int count = job.request.count;
+
+		std::copy(price.begin() + offset, price.begin() + offset + slice.count, job.values.begin() + slice.first);
+
+		if (batch.op == OP_GREEKS) {
+			std::copy(delta.begin() + offset, delta.begin() + offset + slice.count, job.values.begin() + count + slice.first);
+			std::copy(gamma.begin() + offset, gamma.begin() + offset + slice.count, job.values.begin() + 2 * count + slice.first);
+		}
+
+		offset += slice.count;
+
+		if (--job.remaining == 0) {
+			std::lock_guard<std::mutex> lock(m_done_mutex);
+			m_done.push_back(slice.job);
+			finished = true;
+		}
+	}
+
+	if (finished) {
+		unsigned long long one = 1;
+		ssize_t w = write(m_wake, &one, sizeof(one));
+		(void)w;
+	}
+}
+
+#else
+
+// The server is only implemented on Linux
+void PricingServer::Start() {
+	throw SocketException("the pricing server is only available on Linux");
+}
+
+void PricingServer::Stop() {}
+
+void PricingServer::Loop() {}
+void PricingServer::Accept() {}
+void PricingServer::Read(const unsigned long long& id) {}
+void PricingServer::Write(const unsigned long long& id) {}
+void PricingServer::Close(const unsigned long long& id) {}
+void PricingServer::Dispatch() {}
+void PricingServer::Respond() {}
+void PricingServer::Work() {}
+void PricingServer::Price(Batch& batch) {}
+
+#endif
@@ -0,0 +1,212 @@
+// Objective: Create the PricingServer class that prices options for other processes over Unix or TCP sockets
+
+// Ensure no errors if the header file is used twice
+#ifndef PRICINGSERVER_HPP
+#define PRICINGSERVER_HPP
+
+// Include header files
+#include "Serialization.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+using namespace std;
+
+
+
+// The protocol
+// A client sends a PricingRequest followed by count OptionRecords, and the server answers with a PricingResponse followed by count values for OP_PRICE,
+// or 3 * count values (the prices, then the deltas, then the gammas) for OP_GREEKS
+// The id of a request is returned in its response, so a client can have several requests in flight on one connection and match the answers
+// A request with a wrong magic number, an unknown op, or more than PRICING_MAX_RECORDS records closes the connection
+const unsigned int PRICING_MAGIC = 0x50435342;
+const unsigned int PRICING_MAX_RECORDS = 65536;
+
+// The server stops reading a connection while more than PRICING_OUTPUT_LIMIT bytes of its responses are being priced or waiting to be written
+// and reads it again once they are written, so a client that sends requests without reading the responses cannot grow the output without bound
+const std::size_t PRICING_OUTPUT_LIMIT = 4 << 20;
+
+enum PricingOp {
+	OP_PRICE = 1,
+	OP_GREEKS = 2
+};
+
+struct PricingRequest {
+	unsigned int magic;
+	unsigned int op;
+	unsigned int count;
+	unsigned int id;
+};
+
+struct PricingResponse {
+	unsigned int magic;
+	unsigned int op;
+	unsigned int count;
+	unsigned int id;
+};
+
+
+// A global function that returns the number of values in the response to a request
+int ResponseValues(const unsigned int& op, const unsigned int& count);
+
+// A global function that connects a blocking socket to a server
+// An address that starts with '/' is a Unix socket path, and any other address is a TCP port on the loopback interface
+// Throws a SocketException if the connection fails
+int ConnectPricingServer(const std::string& address);
+
+// A global function that closes a socket
+void CloseSocket(const int& fd);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the PricingServer class
+// One event loop thread accepts the connections and reads and writes every socket through epoll, and a pool of workers prices the records
+// After each wait the event loop coalesces the records of every request it has read into batches of m_batch records with the same op,
+// so that many small requests are priced together by the batch kernels and one large request is split across the workers
+// The workers hand the finished requests back to the event loop, which writes the responses
+// The server is only available on Linux, and Start() throws a SocketException elsewhere
+class PricingServer {
+private:
+
+	// A request that is being priced
+	// remaining counts the batches that still have records of the request
+	struct Job {
+		unsigned long long connection;
+		PricingRequest request;
+		std::vector<OptionRecord> records;
+		std::vector<double> values;
+		std::atomic<int> remaining;
+	};
+
+	// A slice of the records of a Job
+	struct Slice {
+		std::shared_ptr<Job> job;
+		int first;
+		int count;
+	};
+
+	// The slices that are priced together by one worker
+	struct Batch {
+		unsigned int op;
+		std::vector<Slice> slices;
+	};
+
+	// A client connection with the bytes that have been read but not parsed, and the bytes that have not been written yet
+	// A client that shuts down its side of the connection is closing: its requests are still answered, and the connection is closed once
+	// its jobs are done and their responses are written
+	// writing and reading are the events that the connection waits for, EPOLLOUT and EPOLLIN
+	// queued is the size of the responses of the jobs that are still being priced
+	struct Connection {
+		int fd;
+		std::vector<char> in;
+		std::vector<char> out;
+		std::size_t written;
+		bool writing;
+		bool reading;
+		bool closing;
+		int jobs;
+		std::size_t queued;
+	};
+
+	// The address, the number of workers, and the number of records per batch
+	std::string m_address;
+	int m_workers;
+	int m_batch;
+
+	// The listening socket, the epoll instance, and the eventfd that wakes the event loop
+	int m_listen;
+	int m_epoll;
+	int m_wake;
+
+	// The connections by id
+	std::map<unsigned long long, Connection> m_connections;
+	unsigned long long m_next;
+
+	// The jobs that have been read and not yet put in a batch, for each op
+	std::vector<std::shared_ptr<Job>> m_pending[2];
+
+	// The batches waiting for a worker
+	std::deque<Batch> m_queue;
+	std::mutex m_queue_mutex;
+	std::condition_variable m_queue_ready;
+
+	// The jobs that are finished and waiting for their responses to be written
+	std::vector<std::shared_ptr<Job>> m_done;
+	std::mutex m_done_mutex;
+
+	// The threads
+	std::thread m_loop;
+	std::vector<std::thread> m_pool;
+	std::atomic<bool> m_running;
+
+	// Statistics
+	std::atomic<unsigned long long> m_requests;
+	std::atomic<unsigned long long> m_records;
+	std::atomic<unsigned long long> m_batches;
+
+	// The event loop
+	void Loop();
+
+	// Accepts every pending connection
+	void Accept();
+
+	// Reads a connection and parses its requests, closing it on end of file, error, or a bad request
+	void Read(const unsigned long long& id);
+
+	// Writes as much of the output of a connection as the socket takes, and waits for the socket to be writable when it does not take all of it
+	// Stops reading the connection while its output, with the responses still being priced, is above PRICING_OUTPUT_LIMIT, and reads it again once it is below
+	void Write(const unsigned long long& id);
+
+	// Closes a connection
+	void Close(const unsigned long long& id);
+
+	// Cuts the pending jobs into batches and hands them to the workers
+	void Dispatch();
+
+	// Appends the responses of the finished jobs to their connections
+	void Respond();
+
+	// The worker loop
+	void Work();
+
+	// Prices a batch
+	void Price(Batch& batch);
+
+	// Servers own their sockets and threads and cannot be copied
+	PricingServer(const PricingServer& source);
+	PricingServer& operator = (const PricingServer& source);
+
+public:
+
+	// Parameter constructor with the address, the number of workers, and the number of records per batch
+	PricingServer(const std::string& address, int workers, int batch);
+
+	// Destructor
+	// Stops the server
+	virtual ~PricingServer();
+
+	// Opens the listening socket and starts the event loop and the workers
+	// Throws a SocketException if the socket cannot be opened
+	void Start();
+
+	// Stops the threads and closes every socket
+	void Stop();
+
+	// Accessors for the address and the statistics
+	std::string Address() const;
+	unsigned long long Requests() const;
+	unsigned long long Records() const;
+	unsigned long long Batches() const;
+
+};
+
+
+
+#endif
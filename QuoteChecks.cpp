@@ -0,0 +1,75 @@
+// Objective: Implement the batch put-call parity and no-arbitrage checks
+
+// Include the necessary header files
+#include "QuoteChecks.hpp"
+#include <iostream>
+using namespace std;
+#include <cmath>
+#include <vector>
+
+
+
+// Checks n call and put quotes
+// The first pass checks each quote on its own, and the second and third passes compare each quote with its neighbours in the same chain
+void CheckQuotes(const int& n, const double* call, const double* put, const double* S, const double* K, const double* T, const double* r, const double* b, const double& tol, unsigned char* flags) {
+
+	// Parity and bounds
+	for (int i = 0; i < n; ++i) {
+
+		double df = exp(-r[i] * T[i]);
+		double forward = S[i] * exp((b[i] - r[i]) * T[i]);
+		double strike = K[i] * df;
+
+		bool parity = abs(call[i] - put[i] - (forward - strike)) > tol;
+
+		bool bounds = (call[i] < forward - strike - tol) | (call[i] < -tol) | (call[i] > forward + tol)
+			| (put[i] < strike - forward - tol) | (put[i] < -tol) | (put[i] > strike + tol);
+
+		flags[i] = (unsigned char)(parity * PARITY_VIOLATION | bounds * BOUNDS_VIOLATION);
+	}
+
+	// Monotonicity in strike against the previous quote of the chain
+	// The call cannot fall faster than the discounted strike rises, and the put cannot rise faster
+	for (int i = 1; i < n; ++i) {
+
+		bool chain = (S[i] == S[i - 1]) & (T[i] == T[i - 1]) & (r[i] == r[i - 1]) & (b[i] == b[i - 1]) & (K[i] > K[i - 1]);
+
+		double dK = (K[i] - K[i - 1]) * exp(-r[i] * T[i]);
+		double dC = call[i] - call[i - 1];
+		double dP = put[i] - put[i - 1];
+
+		bool monotone = (dC > tol) | (dP < -tol) | (-dC > dK + tol) | (dP > dK + tol);
+
+		flags[i] |= (unsigned char)((chain & monotone) * MONOTONICITY_VIOLATION);
+	}
+
+	// Convexity in strike against the previous and next quotes of the chain
+	for (int i = 1; i < n - 1; ++i) {
+
+		bool chain = (S[i] == S[i - 1]) & (T[i] == T[i - 1]) & (r[i] == r[i - 1]) & (b[i] == b[i - 1]) & (K[i] > K[i - 1])
+			& (S[i] == S[i + 1]) & (T[i] == T[i + 1]) & (r[i] == r[i + 1]) & (b[i] == b[i + 1]) & (K[i + 1] > K[i]);
+
+		// Weight of the previous strike in the interpolation at K[i]
+		double w = (K[i + 1] - K[i]) / (K[i + 1] - K[i - 1]);
+
+		bool convex = (call[i] > w * call[i - 1] + (1.0 - w) * call[i + 1] + tol) | (put[i] > w * put[i - 1] + (1.0 - w) * put[i + 1] + tol);
+
+		flags[i] |= (unsigned char)((chain & convex) * CONVEXITY_VIOLATION);
+	}
+}
+
+
+
+// Returns the indices of the quotes with at least one violation
+std::vector<int> Violations(const int& n, const unsigned char* flags) {
+
+	std::vector<int> indices;
+
+	for (int i = 0; i < n; ++i) {
+		if (flags[i] != 0) {
+			indices.push_back(i);
+		}
+	}
+
+	return indices;
+}
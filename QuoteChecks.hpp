@@ -0,0 +1,38 @@
+// Objective: Create the batch put-call parity and no-arbitrage checks for arrays of call and put quotes
+
+// Ensure no errors if the header file is used twice
+#ifndef QUOTECHECKS_HPP
+#define QUOTECHECKS_HPP
+
+// Include header files
+#include <iostream>
+#include <vector>
+using namespace std;
+
+
+
+// The violations that a quote can have, combined into one bitmask per quote
+// PARITY_VIOLATION: C - P differs from S * exp((b - r) * T) - K * exp(-r * T) by more than the tolerance
+// BOUNDS_VIOLATION: the call or the put is outside its model-free bounds
+// MONOTONICITY_VIOLATION: the call increases or the put decreases from the previous strike of the chain, or either moves faster than the discounted strike
+// CONVEXITY_VIOLATION: the call or the put is above the line between the previous and next strikes of the chain
+enum QuoteViolation {
+	PARITY_VIOLATION = 1,
+	BOUNDS_VIOLATION = 2,
+	MONOTONICITY_VIOLATION = 4,
+	CONVEXITY_VIOLATION = 8
+};
+
+
+
+// A global function that checks n call and put quotes stored as arrays, writing one bitmask per quote into flags
+// The quotes of a chain (same S, T, r, and b) must be next to each other in increasing order of strike for the strike checks
+// The loops have no branches so that the compiler can vectorize them
+void CheckQuotes(const int& n, const double* call, const double* put, const double* S, const double* K, const double* T, const double* r, const double* b, const double& tol, unsigned char* flags);
+
+// A global function that returns the indices of the quotes with at least one violation
+std::vector<int> Violations(const int& n, const unsigned char* flags);
+
+
+
+#endif
@@ -0,0 +1,250 @@
+// Objective: Implement the ResultEmitter class
+
+// Include the necessary header files
+#include "ResultEmitter.hpp"
+#include "Exception.hpp"
+#include "Scheduler.hpp"
+#include <iostream>
+using namespace std;
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+
+
+
+// The size of the write buffer
+static const std::size_t BUFFER_BYTES = 1 << 20;
+
+// The most characters of a formatted value, such as -1.2345678901234567e-308
+static const std::size_t VALUE_BYTES = 32;
+
+// The number of rows that one task formats when the emitter is parallel
+static const int CHUNK_ROWS = 16384;
+
+
+
+// Formats rows [first, last) of the columns into out, one line per row
+static void FormatRows(const int& first, const int& last, const std::vector<const double*>& columns, const bool& index, const char& separator, const int& precision, std::vector<char>& out) {
+
+	std::size_t line = (columns.size() + 1) * (VALUE_BYTES + 1) + 1;
+
+	out.resize((last - first) * line);
+
+	char* p = out.data();
+
+	for (int i = first; i < last; ++i) {
+
+		if (index) {
+			p = std::to_chars(p, p + VALUE_BYTES, i).ptr;
+			*p++ = separator;
+		}
+
+		for (std::size_t j = 0; j < columns.size(); ++j) {
+
+			if (j > 0) *p++ = separator;
+
+			p = ResultEmitter::Format(p, columns[j][i], precision);
+		}
+
+		*p++ = '\n';
+	}
+
+	out.resize(p - out.data());
+}
+
+
+
+// Parameter constructor with the path of the output
+ResultEmitter::ResultEmitter(const std::string& path, char separator, int precision, bool parallel) : m_file(0), m_owned(false), m_separator(separator), m_precision(max(1, min(17, precision))), m_parallel(parallel),
+	m_buffer(BUFFER_BYTES), m_used(0), m_bytes(0) {
+
+	if (path == "-") {
+		m_file = stdout;
+		return;
+	}
+
+	m_file = std::fopen(path.c_str(), "wb");
+
+	if (m_file == 0) {
+		throw OutputException("cannot open " + path);
+	}
+
+	m_owned = true;
+
+	// The emitter buffers its own output, so the buffer of the FILE would only add a copy
+	std::setvbuf(m_file, 0, _IONBF, 0);
+}
+
+
+// Parameter constructor with an open output
+ResultEmitter::ResultEmitter(std::FILE* file, char separator, int precision, bool parallel) : m_file(file), m_owned(false), m_separator(separator), m_precision(max(1, min(17, precision))), m_parallel(parallel),
+	m_buffer(BUFFER_BYTES), m_used(0), m_bytes(0) {}
+
+
+// Destructor
+// A destructor cannot throw, so an output that fails here is only closed
+ResultEmitter::~ResultEmitter() {
+
+	try {
+		this->Flush();
+	}
+	catch (...) {}
+
+	if (m_owned) {
+		std::fclose(m_file);
+	}
+}
+
+
+
+// Formats a value with the given number of significant digits
+char* ResultEmitter::Format(char* out, const double& value, const int& precision) {
+	return std::to_chars(out, out + VALUE_BYTES, value, std::chars_format::general, precision).ptr;
+}
+
+
+
+// Makes room for bytes more bytes in the buffer
+char* ResultEmitter::Reserve(const std::size_t& bytes) {
+
+	if (m_used + bytes > m_buffer.size()) {
+
+		this->Flush();
+
+		if (bytes > m_buffer.size()) {
+			m_buffer.resize(bytes);
+		}
+	}
+
+	return m_buffer.data() + m_used;
+}
+
+
+// Appends bytes to the buffer
+// Text longer than the buffer is written straight to the output once the buffer is written out
+void ResultEmitter::Append(const char* text, const std::size_t& bytes) {
+
+	if (bytes > m_buffer.size()) {
+
+		this->Flush();
+
+		if (std::fwrite(text, 1, bytes, m_file) != bytes) {
+			throw OutputException("cannot write the output");
+		}
+
+		m_bytes += bytes;
+		return;
+	}
+
+	std::memcpy(this->Reserve(bytes), text, bytes);
+	m_used += bytes;
+}
+
+
+
+// Writes a line of column names
+void ResultEmitter::Header(const std::vector<std::string>& names) {
+
+	for (std::size_t j = 0; j < names.size(); ++j) {
+
+		if (j > 0) this->Append(&m_separator, 1);
+
+		this->Append(names[j].data(), names[j].size());
+	}
+
+	this->Append("\n", 1);
+}
+
+
+// Writes a line of n values
+void ResultEmitter::Row(const double* values, const int& n) {
+
+	char* start = this->Reserve(n * (VALUE_BYTES + 1) + 1);
+	char* p = start;
+
+	for (int j = 0; j < n; ++j) {
+
+		if (j > 0) *p++ = m_separator;
+
+		p = Format(p, values[j], m_precision);
+	}
+
+	*p++ = '\n';
+
+	m_used += p - start;
+}
+
+
+// Writes one line per row of the columns
+// In parallel, the rows are cut into chunks of CHUNK_ROWS, and a group of chunks, a few per worker, is formatted at a time so the memory stays bounded
+void ResultEmitter::Columns(const int& rows, const std::vector<const double*>& columns, const bool& index) {
+
+	Scheduler& scheduler = Scheduler::Global();
+
+	if (!m_parallel || scheduler.Workers() == 1 || rows < 2 * CHUNK_ROWS) {
+
+		std::vector<char> text;
+
+		for (int first = 0; first < rows; first += CHUNK_ROWS) {
+
+			FormatRows(first, min(rows, first + CHUNK_ROWS), columns, index, m_separator, m_precision, text);
+			this->Append(text.data(), text.size());
+		}
+
+		return;
+	}
+
+	int chunks = (rows + CHUNK_ROWS - 1) / CHUNK_ROWS;
+	int group = 4 * scheduler.Workers();
+
+	std::vector<std::vector<char>> texts(group);
+
+	for (int first = 0; first < chunks; first += group) {
+
+		int count = min(group, chunks - first);
+
+		scheduler.ParallelFor(0, count, 1, [&](int a, int b) {
+			for (int c = a; c < b; ++c) {
+				int row = (first + c) * CHUNK_ROWS;
+				FormatRows(row, min(rows, row + CHUNK_ROWS), columns, index, m_separator, m_precision, texts[c]);
+			}
+		});
+
+		for (int c = 0; c < count; ++c) {
+			this->Append(texts[c].data(), texts[c].size());
+		}
+	}
+}
+
+
+
+// Writes out the buffer and flushes the output
+void ResultEmitter::Flush() {
+
+	if (m_used > 0) {
+
+		std::size_t written = std::fwrite(m_buffer.data(), 1, m_used, m_file);
+
+		m_bytes += written;
+
+		if (written != m_used) {
+			m_used = 0;
+			throw OutputException("cannot write the output");
+		}
+
+		m_used = 0;
+	}
+
+	if (std::fflush(m_file) != 0) {
+		throw OutputException("cannot flush the output");
+	}
+}
+
+
+// Returns the number of bytes written to the output so far, including the buffer
+unsigned long long ResultEmitter::Bytes() const {
+	return m_bytes + m_used;
+}
@@ -0,0 +1,91 @@
+// Objective: Create the ResultEmitter class that writes pricing results as CSV or TSV text at the speed of the file or pipe
+
+// Ensure no errors if the header file is used twice
+#ifndef RESULTEMITTER_HPP
+#define RESULTEMITTER_HPP
+
+// Include header files
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+using namespace std;
+
+
+
+// The separators of the two text formats
+const char CSV = ',';
+const char TSV = '\t';
+
+
+// Create the ResultEmitter class
+// Values are formatted with std::to_chars, which neither allocates nor looks at the locale, into a large buffer that is written with one fwrite when it is full,
+// instead of going through std::cout and endl, which format through the stream and flush the output for every value
+// Every value is written with m_precision significant digits in the shortest of the fixed and scientific forms
+// When the emitter is parallel, Columns() formats chunks of rows on the Scheduler and writes the chunks in order
+class ResultEmitter {
+private:
+
+	// The output, and whether the emitter opened it and must close it
+	std::FILE* m_file;
+	bool m_owned;
+
+	// The format
+	char m_separator;
+	int m_precision;
+	bool m_parallel;
+
+	// The buffer and the number of bytes of it in use
+	std::vector<char> m_buffer;
+	std::size_t m_used;
+
+	// The number of bytes written to the output
+	unsigned long long m_bytes;
+
+	// Makes room for bytes more bytes in the buffer, writing the buffer out if needed
+	char* Reserve(const std::size_t& bytes);
+
+	// Appends bytes to the buffer
+	void Append(const char* text, const std::size_t& bytes);
+
+	// ResultEmitters own their buffer and output and cannot be copied
+	ResultEmitter(const ResultEmitter& source);
+	ResultEmitter& operator = (const ResultEmitter& source);
+
+public:
+
+	// Parameter constructor with the path of the output, or "-" for the standard output, the separator, the number of significant digits, and whether to format in parallel
+	// Throws an OutputException if the file cannot be opened
+	ResultEmitter(const std::string& path, char separator, int precision, bool parallel);
+
+	// Parameter constructor with an open output, such as a pipe from popen, which the emitter does not close
+	ResultEmitter(std::FILE* file, char separator, int precision, bool parallel);
+
+	// Destructor
+	// Writes out the buffer and closes the output if the emitter opened it
+	virtual ~ResultEmitter();
+
+	// Writes a line of column names
+	void Header(const std::vector<std::string>& names);
+
+	// Writes a line of n values
+	void Row(const double* values, const int& n);
+
+	// Writes one line per row of the columns, each of which holds rows values, optionally led by the index of the row
+	void Columns(const int& rows, const std::vector<const double*>& columns, const bool& index);
+
+	// Writes out the buffer and flushes the output
+	// Throws an OutputException if the output cannot be written
+	void Flush();
+
+	// Returns the number of bytes written to the output so far, including the buffer
+	unsigned long long Bytes() const;
+
+	// Formats a value into out, which must hold at least 32 characters, and returns the end of the text
+	static char* Format(char* out, const double& value, const int& precision);
+
+};
+
+
+
+#endif
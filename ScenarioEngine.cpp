@@ -0,0 +1,197 @@
+// Objective: Implement the ScenarioEngine class
+
+// Include the necessary header files
+#include "ScenarioEngine.hpp"
+#include "EuropeanOption.hpp"
+#include "Kernels.hpp"
+#include <iostream>
+using namespace std;
+#include <cmath>
+#include <vector>
+#include <thread>
+#include "Scheduler.hpp"
+#include <algorithm>
+
+
+
+// The size of a tile: the parameters of POSITION_TILE positions and the P&L of SCENARIO_TILE scenarios stay in the L1 cache while the tile is revalued
+static const int POSITION_TILE = 64;
+static const int SCENARIO_TILE = 256;
+
+
+
+// Default constructor
+ScenarioEngine::ScenarioEngine() : m_options(), m_spots(), m_quantities(), m_pnl(), m_threads(max(1, int(std::thread::hardware_concurrency()))) {}
+
+
+// Parameter constructor
+ScenarioEngine::ScenarioEngine(int threads) : m_options(), m_spots(), m_quantities(), m_pnl(), m_threads(max(1, threads)) {}
+
+
+// Destructor
+ScenarioEngine::~ScenarioEngine() {}
+
+
+// Copy constructor
+ScenarioEngine::ScenarioEngine(const ScenarioEngine& source) : m_options(source.m_options), m_spots(source.m_spots), m_quantities(source.m_quantities), m_pnl(source.m_pnl), m_threads(source.m_threads) {}
+
+
+// Assignment operator
+ScenarioEngine& ScenarioEngine::operator = (const ScenarioEngine& source) {
+
+	if (this == &source) {
+		return *this;
+	}
+
+	m_options = source.m_options;
+	m_spots = source.m_spots;
+	m_quantities = source.m_quantities;
+	m_pnl = source.m_pnl;
+	m_threads = source.m_threads;
+
+	return *this;
+}
+
+
+
+// Adds a position to the book
+void ScenarioEngine::AddPosition(const EuropeanOption& option, const double& S, const double& quantity) {
+	m_options.push_back(option);
+	m_spots.push_back(S);
+	m_quantities.push_back(quantity);
+}
+
+
+// Returns the number of positions in the book
+int ScenarioEngine::Positions() const {
+	return m_options.size();
+}
+
+
+
+// Revalues the book under the scenarios in [first, last)
+// Each call writes only its own range of m_pnl, so the threads never share an output
+void ScenarioEngine::RevalueRange(const std::vector<Scenario>& scenarios, const int& first, const int& last) {
+
+	int n = m_options.size();
+
+	// The parameters of the positions of one tile
+	double K[POSITION_TILE], T[POSITION_TILE], r[POSITION_TILE], b[POSITION_TILE], sig[POSITION_TILE], S[POSITION_TILE], q[POSITION_TILE], cf[POSITION_TILE], base[POSITION_TILE];
+	bool call[POSITION_TILE];
+
+	for (int s = first; s < last; ++s) {
+		m_pnl[s] = 0;
+	}
+
+	for (int p0 = 0; p0 < n; p0 += POSITION_TILE) {
+
+		int np = min(POSITION_TILE, n - p0);
+
+		// Load the tile of positions once
+		// A parallel shift of r and b leaves exp((b - r) * T) unchanged, so it is computed once per position
+		for (int j = 0; j < np; ++j) {
+
+			const EuropeanOption& option = m_options[p0 + j];
+
+			K[j] = option.StrikePrice();
+			T[j] = option.Expiry();
+			r[j] = option.RiskFreeRate();
+			b[j] = option.CostOfCarry();
+			sig[j] = option.Volatility();
+			S[j] = m_spots[p0 + j];
+			q[j] = m_quantities[p0 + j];
+			cf[j] = exp((b[j] - r[j]) * T[j]);
+			call[j] = option.OptionType() == "Call";
+			base[j] = option.Price(S[j]);
+		}
+
+		for (int s0 = first; s0 < last; s0 += SCENARIO_TILE) {
+
+			int s1 = min(s0 + SCENARIO_TILE, last);
+
+			for (int j = 0; j < np; ++j) {
+				for (int s = s0; s < s1; ++s) {
+
+					double shockedS = S[j] * (1.0 + scenarios[s].spot);
+					double shockedsig = sig[j] + scenarios[s].vol;
+					double shockedr = r[j] + scenarios[s].rate;
+					double shockedb = b[j] + scenarios[s].rate;
+					double df = exp(-shockedr * T[j]);
+
+					double value = call[j] ? EuropeanCall<double>(shockedS, K[j], T[j], shockedb, shockedsig, df, cf[j]) : EuropeanPut<double>(shockedS, K[j], T[j], shockedb, shockedsig, df, cf[j]);
+
+					m_pnl[s] += q[j] * (value - base[j]);
+				}
+			}
+		}
+	}
+}
+
+
+
+// Revalues the book under every scenario
+// The scenarios are handed to the Scheduler as one loop of at most m_threads tasks with a grain of one tile, or revalued on the calling thread when the engine has one thread
+const std::vector<double>& ScenarioEngine::Revalue(const std::vector<Scenario>& scenarios) {
+
+	int m = scenarios.size();
+
+	m_pnl.assign(m, 0.0);
+
+	if (m_threads == 1) {
+		this->RevalueRange(scenarios, 0, m);
+		return m_pnl;
+	}
+
+	Scheduler::Global().ParallelFor(0, m, SCENARIO_TILE, [this, &scenarios](int first, int last) { this->RevalueRange(scenarios, first, last); }, m_threads);
+
+	return m_pnl;
+}
+
+
+
+// Accessor for the P&L of the last revaluation
+const std::vector<double>& ScenarioEngine::PnL() const {
+	return m_pnl;
+}
+
+
+
+// Returns the index of the P&L at the given confidence in the P&L sorted from the largest loss up
+int ScenarioEngine::Tail(const std::vector<double>& sorted, const double& confidence) const {
+	return min(int(sorted.size()) - 1, int(floor((1.0 - confidence) * sorted.size())));
+}
+
+
+// Value at risk: the loss that is only exceeded in (1 - confidence) of the scenarios
+double ScenarioEngine::VaR(const double& confidence) const {
+
+	if (m_pnl.empty()) {
+		return 0;
+	}
+
+	std::vector<double> sorted = m_pnl;
+	std::sort(sorted.begin(), sorted.end());
+
+	return -sorted[this->Tail(sorted, confidence)];
+}
+
+
+// Expected shortfall: the average loss of the scenarios at or beyond the value at risk
+double ScenarioEngine::ExpectedShortfall(const double& confidence) const {
+
+	if (m_pnl.empty()) {
+		return 0;
+	}
+
+	std::vector<double> sorted = m_pnl;
+	std::sort(sorted.begin(), sorted.end());
+
+	int tail = this->Tail(sorted, confidence);
+	double sum = 0;
+
+	for (int i = 0; i <= tail; ++i) {
+		sum += sorted[i];
+	}
+
+	return -sum / (tail + 1);
+}
@@ -0,0 +1,93 @@
+// Objective: Create the ScenarioEngine class that revalues a book of European Options under stress and historical scenarios
+
+// Ensure no errors if the header file is used twice
+#ifndef SCENARIOENGINE_HPP
+#define SCENARIOENGINE_HPP
+
+// Include header files
+#include "EuropeanOption.hpp"
+#include <iostream>
+#include <vector>
+using namespace std;
+
+
+
+// Create the Scenario struct
+// spot: relative shock of the spot price, so S becomes S * (1 + spot)
+// vol: absolute shock of the volatility
+// rate: absolute shock of the risk free rate, which also shifts the cost of carry so that b - r is unchanged
+struct Scenario {
+	double spot;
+	double vol;
+	double rate;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the ScenarioEngine class
+// The shocks are applied to copies of the parameters, so the options of the book are never modified
+// Revaluation is handed to the Scheduler by scenarios, and each piece works through tiles of positions x scenarios that fit in cache
+class ScenarioEngine {
+private:
+
+	// The book: the options, their spot prices, and their quantities
+	std::vector<EuropeanOption> m_options;
+	std::vector<double> m_spots;
+	std::vector<double> m_quantities;
+
+	// The P&L of the book under each scenario of the last revaluation
+	std::vector<double> m_pnl;
+
+	// The number of threads used to revalue
+	// The loop over the scenarios is split into at most this many tasks of the Scheduler, so no more threads than this, and than the Scheduler has workers, run it
+	int m_threads;
+
+	// Revalues the book under the scenarios in [first, last) into m_pnl
+	void RevalueRange(const std::vector<Scenario>& scenarios, const int& first, const int& last);
+
+	// Returns the index of the P&L at the given confidence in the sorted P&L
+	int Tail(const std::vector<double>& sorted, const double& confidence) const;
+
+public:
+
+	// Default constructor
+	// Uses one thread per hardware thread
+	ScenarioEngine();
+
+	// Parameter constructor with the number of threads, where a number below 1 is taken as 1
+	// With 1 thread the book is revalued on the calling thread
+	ScenarioEngine(int threads);
+
+	// Destructor
+	virtual ~ScenarioEngine();
+
+	// Copy constructor
+	ScenarioEngine(const ScenarioEngine& source);
+
+	// Assignment operator
+	ScenarioEngine& operator = (const ScenarioEngine& source);
+
+	// Adds a position to the book
+	void AddPosition(const EuropeanOption& option, const double& S, const double& quantity);
+
+	// Returns the number of positions in the book
+	int Positions() const;
+
+	// Revalues the book under every scenario and returns the P&L of each scenario
+	const std::vector<double>& Revalue(const std::vector<Scenario>& scenarios);
+
+	// Accessor for the P&L of the last revaluation
+	const std::vector<double>& PnL() const;
+
+	// Value at risk of the last revaluation at a confidence such as 0.99, as a positive loss
+	double VaR(const double& confidence) const;
+
+	// Expected shortfall of the last revaluation at a confidence such as 0.975, as a positive loss
+	double ExpectedShortfall(const double& confidence) const;
+
+};
+
+
+
+#endif
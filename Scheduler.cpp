@@ -0,0 +1,323 @@
+// Objective: Implement the Scheduler class
+
+// Include the necessary header files
+#include "Scheduler.hpp"
+#include "Exception.hpp"
+#include <iostream>
+using namespace std;
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <climits>
+
+
+
+// The Scheduler and the index of the worker that the calling thread belongs to, if any
+static thread_local Scheduler* t_scheduler = 0;
+static thread_local int t_index = -1;
+
+
+// Returns the steady clock in nanoseconds
+static long long Nanoseconds() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+// Parameter constructor
+// Starts at least one worker
+Scheduler::Scheduler(int threads) : m_workers(), m_threads(), m_queued(0), m_stopping(false), m_next(0), m_since(Nanoseconds()) {
+
+	for (int i = 0; i < max(1, threads); ++i) {
+
+		m_workers.push_back(std::unique_ptr<Worker>(new Worker));
+		m_workers[i]->pieces = 0;
+		m_workers[i]->steals = 0;
+		m_workers[i]->busy = 0;
+	}
+
+	for (int i = 0; i < max(1, threads); ++i) {
+		m_threads.push_back(std::thread(&Scheduler::Work, this, i));
+	}
+}
+
+
+// Destructor
+Scheduler::~Scheduler() {
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleep);
+		m_stopping = true;
+	}
+
+	m_wake.notify_all();
+
+	for (std::size_t i = 0; i < m_threads.size(); ++i) {
+		m_threads[i].join();
+	}
+}
+
+
+// Returns the Scheduler shared by the library
+Scheduler& Scheduler::Global() {
+	static Scheduler scheduler(max(1, int(std::thread::hardware_concurrency())));
+	return scheduler;
+}
+
+
+// Returns the number of workers
+int Scheduler::Workers() const {
+	return m_workers.size();
+}
+
+
+// Runs body over [first, last)
+void Scheduler::ParallelFor(const int& first, const int& last, const int& grain, const std::function<void(int, int)>& body, const int& tasks) {
+
+	if (last <= first) return;
+
+	Job job;
+	job.body = &body;
+	job.grain = grain > 0 ? grain : max(1, (last - first) / (8 * this->Workers()));
+	job.limit = tasks > 0 ? tasks : INT_MAX;
+	job.pending = 1;
+
+	Task root = { &job, first, last };
+
+	// A worker keeps working while it waits, so loops inside loop bodies cannot run out of threads
+	if (t_scheduler == this) {
+
+		this->Push(t_index, root);
+
+		Task task;
+
+		while (job.pending > 0) {
+
+			if (this->Pop(t_index, task) || this->Steal(t_index, task)) {
+				this->Execute(t_index, task);
+			}
+
+			else {
+				std::this_thread::yield();
+			}
+		}
+
+		// Wait for the worker that finished the last task to release the job
+		std::lock_guard<std::mutex> lock(job.mutex);
+	}
+
+	else {
+
+		this->Push(m_next++ % m_workers.size(), root);
+
+		std::unique_lock<std::mutex> lock(job.mutex);
+
+		while (job.pending > 0) {
+			job.done.wait(lock);
+		}
+	}
+
+	if (job.error) {
+		std::rethrow_exception(job.error);
+	}
+}
+
+
+// Pushes a task onto the back of a deque and wakes a sleeping worker
+void Scheduler::Push(const int& index, const Task& task) {
+
+	{
+		std::lock_guard<std::mutex> lock(m_workers[index]->mutex);
+		m_workers[index]->tasks.push_back(task);
+	}
+
+	++m_queued;
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleep);
+	}
+
+	m_wake.notify_one();
+}
+
+
+// Takes the newest task of a worker's own deque
+bool Scheduler::Pop(const int& index, Task& task) {
+
+	Worker& worker = *m_workers[index];
+	std::lock_guard<std::mutex> lock(worker.mutex);
+
+	if (worker.tasks.empty()) return false;
+
+	task = worker.tasks.back();
+	worker.tasks.pop_back();
+	--m_queued;
+
+	return true;
+}
+
+
+// Steals the oldest task of another deque, which is the largest range that deque holds
+// The victims are tried in turn starting after the thief, so the thieves spread over the deques
+bool Scheduler::Steal(const int& index, Task& task) {
+
+	int n = m_workers.size();
+
+	for (int k = 1; k < n; ++k) {
+
+		Worker& victim = *m_workers[(index + k) % n];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+
+		if (victim.tasks.empty()) continue;
+
+		task = victim.tasks.front();
+		victim.tasks.pop_front();
+		--m_queued;
+
+		++m_workers[index]->steals;
+
+		return true;
+	}
+
+	return false;
+}
+
+
+// Runs a task one grain at a time
+// Before each grain, if the deque of the worker is empty and the job is below its limit of tasks, the second half of what is left is pushed onto it for the thieves
+// The task is cut on a whole number of grains from its start, so every range that the body sees starts at the first index of the loop plus a multiple of the grain
+void Scheduler::Execute(const int& index, Task task) {
+
+	Worker& worker = *m_workers[index];
+	Job& job = *task.job;
+
+	while (task.first < task.last) {
+
+		if (task.last - task.first > job.grain) {
+
+			bool empty;
+
+			{
+				std::lock_guard<std::mutex> lock(worker.mutex);
+				empty = worker.tasks.empty();
+			}
+
+			// The task count is raised only if it stays within the limit, since other workers may be splitting the same job
+			int pending = job.pending;
+
+			while (empty && pending < job.limit && !job.pending.compare_exchange_weak(pending, pending + 1)) {}
+
+			if (empty && pending < job.limit) {
+
+				int grains = (task.last - task.first + job.grain - 1) / job.grain;
+				int mid = task.first + grains / 2 * job.grain;
+				Task half = { &job, mid, task.last };
+
+				this->Push(index, half);
+
+				task.last = mid;
+				continue;
+			}
+		}
+
+		int end = min(task.last, task.first + job.grain);
+		long long start = Nanoseconds();
+
+		try {
+			(*job.body)(task.first, end);
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(job.mutex);
+			if (!job.error) job.error = std::current_exception();
+		}
+
+		worker.busy += Nanoseconds() - start;
+		++worker.pieces;
+
+		task.first = end;
+	}
+
+	// The last task of a job wakes the thread waiting in ParallelFor
+	// The count is only taken to 0 under the lock, so the waiting thread cannot return and destroy the job while the lock is held
+	std::lock_guard<std::mutex> lock(job.mutex);
+
+	if (--job.pending == 0) {
+		job.done.notify_all();
+	}
+}
+
+
+// The worker loop
+// An idle worker sleeps until a task is pushed
+void Scheduler::Work(const int& index) {
+
+	t_scheduler = this;
+	t_index = index;
+
+	Task task;
+
+	while (true) {
+
+		if (this->Pop(index, task) || this->Steal(index, task)) {
+			this->Execute(index, task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleep);
+
+		while (m_queued == 0 && !m_stopping) {
+			m_wake.wait(lock);
+		}
+
+		if (m_stopping && m_queued == 0) return;
+	}
+}
+
+
+// Accessors for the statistics
+unsigned long long Scheduler::Pieces(const int& index) const {
+
+	if (index < 0 || index >= this->Workers()) throw OutOfBoundsException(index);
+
+	return m_workers[index]->pieces;
+}
+
+unsigned long long Scheduler::Steals(const int& index) const {
+
+	if (index < 0 || index >= this->Workers()) throw OutOfBoundsException(index);
+
+	return m_workers[index]->steals;
+}
+
+double Scheduler::Utilization(const int& index) const {
+
+	if (index < 0 || index >= this->Workers()) throw OutOfBoundsException(index);
+
+	long long wall = Nanoseconds() - m_since;
+
+	return wall > 0 ? double(m_workers[index]->busy) / wall : 0.0;
+}
+
+
+// Sets every statistic back to 0
+void Scheduler::ResetStatistics() {
+
+	for (std::size_t i = 0; i < m_workers.size(); ++i) {
+		m_workers[i]->pieces = 0;
+		m_workers[i]->steals = 0;
+		m_workers[i]->busy = 0;
+	}
+
+	m_since = Nanoseconds();
+}
+
+
+// Outputs the statistics of every worker
+void Scheduler::OutputStatistics() const {
+
+	std::cout << "Worker:" << '\t' << "Pieces:" << '\t' << '\t' << "Steals:" << '\t' << '\t' << "Utilization:" << endl;
+
+	for (int i = 0; i < Workers(); ++i) {
+		std::cout << i << '\t' << Pieces(i) << '\t' << '\t' << Steals(i) << '\t' << '\t' << Utilization(i) << endl;
+	}
+}
@@ -0,0 +1,131 @@
+// Objective: Create the Scheduler class, a work-stealing scheduler that the batch pricers submit their loops to
+
+// Ensure no errors if the header file is used twice
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+// Include header files
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
+using namespace std;
+
+
+
+// Create the Scheduler class
+// Every worker thread has its own deque of tasks: it takes its newest task from the back, and a worker with nothing to do steals the oldest task from the front of another deque
+// A task is a range of a loop, and it is split lazily: while its worker's deque is empty, the worker pushes the second half of what is left of its range onto the deque
+// So a range is only cut up when other workers are stealing, cheap loops run in a few large pieces, and expensive or uneven loops are spread over every worker
+// A loop can also be given a limit on its tasks: it is only split while it has fewer tasks than the limit, so no more than that many workers run it at once
+// Each worker counts the pieces it ran, the tasks it stole, and the time it spent in loop bodies, so its utilization can be reported
+class Scheduler {
+private:
+
+	// A loop submitted to ParallelFor
+	// pending counts the tasks of the loop that have not finished, and is never raised above limit
+	struct Job {
+		const std::function<void(int, int)>* body;
+		int grain;
+		int limit;
+		std::atomic<int> pending;
+		std::exception_ptr error;
+		std::mutex mutex;
+		std::condition_variable done;
+	};
+
+	// A range of a loop
+	struct Task {
+		Job* job;
+		int first;
+		int last;
+	};
+
+	// The deque and the statistics of a worker
+	struct Worker {
+		std::deque<Task> tasks;
+		std::mutex mutex;
+		std::atomic<unsigned long long> pieces;
+		std::atomic<unsigned long long> steals;
+		std::atomic<unsigned long long> busy;
+	};
+
+	// The workers and their threads
+	std::vector<std::unique_ptr<Worker>> m_workers;
+	std::vector<std::thread> m_threads;
+
+	// The number of tasks in every deque, which idle workers sleep on
+	std::atomic<int> m_queued;
+	std::mutex m_sleep;
+	std::condition_variable m_wake;
+	bool m_stopping;
+
+	// The worker that the next loop from outside the Scheduler is given to
+	std::atomic<unsigned int> m_next;
+
+	// The start of the statistics in nanoseconds of the steady clock
+	std::atomic<long long> m_since;
+
+	// The worker loop
+	void Work(const int& index);
+
+	// Pushes a task onto the back of a deque
+	void Push(const int& index, const Task& task);
+
+	// Takes the newest task of a worker's own deque, or steals the oldest task of another deque
+	bool Pop(const int& index, Task& task);
+	bool Steal(const int& index, Task& task);
+
+	// Runs a task, splitting it while the deque of the worker is empty
+	void Execute(const int& index, Task task);
+
+	// Schedulers own their threads and cannot be copied
+	Scheduler(const Scheduler& source);
+	Scheduler& operator = (const Scheduler& source);
+
+public:
+
+	// Parameter constructor with the number of worker threads
+	Scheduler(int threads);
+
+	// Destructor
+	// Stops the workers once every deque is empty
+	virtual ~Scheduler();
+
+	// Returns the Scheduler shared by the library, with one worker per hardware thread
+	static Scheduler& Global();
+
+	// Runs body(begin, end) over ranges that cover [first, last), with each range at most grain long, and returns when every range has run
+	// Every range starts at first plus a multiple of grain, so a caller that works in tiles and passes a multiple of the tile as the grain gets whole tiles
+	// A grain of 0 or less is chosen from the length of the loop and the number of workers
+	// At most tasks tasks of the loop exist at once, so at most tasks bodies run at the same time, which is how a caller limits the threads of one loop
+	// A limit of 0 or less leaves the loop free to spread over every worker
+	// Called from a worker, as by a loop body that starts a loop of its own, the worker runs tasks until the inner loop is finished instead of blocking
+	// Throws the first exception of the body again once every range has run
+	void ParallelFor(const int& first, const int& last, const int& grain, const std::function<void(int, int)>& body, const int& tasks = 0);
+
+	// Returns the number of workers
+	int Workers() const;
+
+	// Returns the pieces of loops a worker ran, the tasks it stole, and the fraction of the time since the statistics were reset that it spent in loop bodies
+	unsigned long long Pieces(const int& index) const;
+	unsigned long long Steals(const int& index) const;
+	double Utilization(const int& index) const;
+
+	// Sets every statistic back to 0
+	void ResetStatistics();
+
+	// Outputs the statistics of every worker
+	void OutputStatistics() const;
+
+};
+
+
+
+#endif
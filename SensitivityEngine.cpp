@@ -0,0 +1,258 @@
+// Objective: Implement the SensitivityEngine class
+
+// Include the necessary header files
+#include "SensitivityEngine.hpp"
+#include "Matrix.hpp"
+#include "Exception.hpp"
+#include "Kernels.hpp"
+#include <iostream>
+using namespace std;
+#include <cmath>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+
+
+// The bumped parameters in the order of the points of a row: S, K, T, r, b, and sig
+static const int PARAMETERS = 6;
+
+// The base point and an up and a down bump of each parameter
+static const int POINTS = 1 + 2 * PARAMETERS;
+
+// The number of rows priced by one call of the batch kernel, so the points of a block stay in the L1 cache
+static const int BLOCK_ROWS = 64;
+
+// The column of the first derivative in each parameter
+static const int COLUMNS[PARAMETERS] = { SENS_DELTA, SENS_STRIKE, SENS_EXPIRY, SENS_RATE, SENS_CARRY, SENS_VEGA };
+
+// The index of each parameter in the Vectors of each style, or -1 if the style does not have it
+static const int EO_INDEX[PARAMETERS] = { 0, 1, 2, 3, 4, 5 };
+static const int PAO_INDEX[PARAMETERS] = { 0, 1, -1, 2, 3, 4 };
+
+// True for the parameters that must stay positive: S, K, T, and sig
+static const bool POSITIVE[PARAMETERS] = { true, true, true, false, false, true };
+
+
+
+// Lays out the points of one row at offset p of the parameter arrays and returns the bumps in h
+// A parameter that the style does not have keeps its base value and a bump of 0
+static void FillPoints(const Vector& row, const int* index, const double& bump, const int& p, double* const* params, double* h) {
+
+	for (int j = 0; j < PARAMETERS; ++j) {
+
+		double x = index[j] < 0 ? 0 : row[index[j]];
+
+		for (int k = 0; k < POINTS; ++k) {
+			params[j][p + k] = x;
+		}
+
+		h[j] = 0;
+
+		if (index[j] < 0) continue;
+
+		h[j] = bump * max(abs(x), 1.0);
+
+		// A bump of a positive parameter never takes it to 0 or below
+		if (POSITIVE[j]) {
+			h[j] = min(h[j], 0.5 * x);
+		}
+
+		params[j][p + 1 + 2 * j] = x + h[j];
+		params[j][p + 2 + 2 * j] = x - h[j];
+	}
+}
+
+
+// Turns the prices of the points of one row into the columns of one side
+static void Differences(const double* v, const double* h, double* out) {
+
+	out[SENS_PRICE] = v[0];
+	out[SENS_GAMMA] = (v[1] - 2 * v[0] + v[2]) / (h[0] * h[0]);
+
+	for (int j = 0; j < PARAMETERS; ++j) {
+		out[COLUMNS[j]] = h[j] > 0 ? (v[1 + 2 * j] - v[2 + 2 * j]) / (2 * h[j]) : 0;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Default constructor
+SensitivityEngine::SensitivityEngine() : m_bump(1e-4), m_table(), m_rows(0) {}
+
+
+// Parameter constructor
+SensitivityEngine::SensitivityEngine(double bump) : m_bump(bump), m_table(), m_rows(0) {}
+
+
+// Destructor
+SensitivityEngine::~SensitivityEngine() {}
+
+
+// Copy constructor
+SensitivityEngine::SensitivityEngine(const SensitivityEngine& source) : m_bump(source.m_bump), m_table(source.m_table), m_rows(source.m_rows) {}
+
+
+// Assignment operator
+SensitivityEngine& SensitivityEngine::operator = (const SensitivityEngine& source) {
+
+	if (this == &source) {
+		return *this;
+	}
+
+	m_bump = source.m_bump;
+	m_table = source.m_table;
+	m_rows = source.m_rows;
+
+	return *this;
+}
+
+
+
+// Computes the table of a Matrix
+// The style of the first row is used for every row, as in the MatrixPricer
+void SensitivityEngine::Compute(const Matrix& matrix) {
+
+	m_rows = matrix.GetSize();
+	m_table.assign(m_rows * 2 * SENS_COLUMNS, 0.0);
+
+	if (m_rows == 0) return;
+
+	if (matrix[0].OptionStyle() == "EO") {
+		this->ComputeEO(matrix);
+	}
+
+	else if (matrix[0].OptionStyle() == "PAO") {
+		this->ComputePAO(matrix);
+	}
+}
+
+
+
+// Fills the table for a Matrix of EuropeanOptions
+// The points of BLOCK_ROWS rows are priced with one call of PriceBatch
+void SensitivityEngine::ComputeEO(const Matrix& matrix) {
+
+	int n = BLOCK_ROWS * POINTS;
+
+	std::vector<double> S(n), K(n), T(n), r(n), b(n), sig(n), call(n), put(n);
+	std::vector<double> h(BLOCK_ROWS * PARAMETERS);
+
+	double* params[PARAMETERS] = { &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0] };
+
+	for (int first = 0; first < m_rows; first += BLOCK_ROWS) {
+
+		int rows = min(BLOCK_ROWS, m_rows - first);
+
+		for (int i = 0; i < rows; ++i) {
+			FillPoints(matrix[first + i], EO_INDEX, m_bump, i * POINTS, params, &h[i * PARAMETERS]);
+		}
+
+		PriceBatch(rows * POINTS, &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0], &call[0], &put[0]);
+
+		for (int i = 0; i < rows; ++i) {
+
+			double* out = &m_table[(first + i) * 2 * SENS_COLUMNS];
+
+			Differences(&call[i * POINTS], &h[i * PARAMETERS], out);
+			Differences(&put[i * POINTS], &h[i * PARAMETERS], out + SENS_COLUMNS);
+		}
+	}
+}
+
+
+
+// Fills the table for a Matrix of PerpetualAmericanOptions
+// The points are laid out as for EuropeanOptions and priced with the scalar kernels
+void SensitivityEngine::ComputePAO(const Matrix& matrix) {
+
+	std::vector<double> S(POINTS), K(POINTS), T(POINTS), r(POINTS), b(POINTS), sig(POINTS), call(POINTS), put(POINTS);
+	double h[PARAMETERS];
+
+	double* params[PARAMETERS] = { &S[0], &K[0], &T[0], &r[0], &b[0], &sig[0] };
+
+	for (int i = 0; i < m_rows; ++i) {
+
+		FillPoints(matrix[i], PAO_INDEX, m_bump, 0, params, h);
+
+		for (int k = 0; k < POINTS; ++k) {
+			call[k] = PerpetualCall<double>(S[k], K[k], r[k], b[k], sig[k]);
+			put[k] = PerpetualPut<double>(S[k], K[k], r[k], b[k], sig[k]);
+		}
+
+		double* out = &m_table[i * 2 * SENS_COLUMNS];
+
+		Differences(&call[0], h, out);
+		Differences(&put[0], h, out + SENS_COLUMNS);
+	}
+}
+
+
+
+// Returns the number of rows of the table
+int SensitivityEngine::Rows() const {
+	return m_rows;
+}
+
+
+// Returns a column of a row for the call
+double SensitivityEngine::Call(const int& row, const int& column) const {
+
+	if (row < 0 || row >= m_rows) throw OutOfBoundsException(row);
+	if (column < 0 || column >= SENS_COLUMNS) throw OutOfBoundsException(column);
+
+	return m_table[row * 2 * SENS_COLUMNS + column];
+}
+
+
+// Returns a column of a row for the put
+double SensitivityEngine::Put(const int& row, const int& column) const {
+
+	if (row < 0 || row >= m_rows) throw OutOfBoundsException(row);
+	if (column < 0 || column >= SENS_COLUMNS) throw OutOfBoundsException(column);
+
+	return m_table[row * 2 * SENS_COLUMNS + SENS_COLUMNS + column];
+}
+
+
+// Returns the whole table
+const std::vector<double>& SensitivityEngine::Table() const {
+	return m_table;
+}
+
+
+// Returns the name of a column
+std::string SensitivityEngine::Name(const int& column) {
+
+	static const char* names[SENS_COLUMNS] = { "Price:", "Delta:", "Gamma:", "dK:", "dT:", "Rho:", "dB:", "Vega:" };
+
+	if (column < 0 || column >= SENS_COLUMNS) throw OutOfBoundsException(column);
+
+	return names[column];
+}
+
+
+// Outputs the table of one side, one row per line
+void SensitivityEngine::OutputTable(const bool& call) const {
+
+	std::cout << "Row:";
+
+	for (int c = 0; c < SENS_COLUMNS; ++c) {
+		std::cout << '\t' << Name(c);
+	}
+
+	std::cout << endl;
+
+	for (int i = 0; i < m_rows; ++i) {
+
+		std::cout << i;
+
+		for (int c = 0; c < SENS_COLUMNS; ++c) {
+			std::cout << '\t' << (call ? this->Call(i, c) : this->Put(i, c));
+		}
+
+		std::cout << endl;
+	}
+}
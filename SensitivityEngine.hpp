@@ -0,0 +1,96 @@
+// Objective: Create the SensitivityEngine class that bumps every parameter of every row of a Matrix in one pass
+
+// Ensure no errors if the header file is used twice
+#ifndef SENSITIVITYENGINE_HPP
+#define SENSITIVITYENGINE_HPP
+
+// Include header files
+#include "Matrix.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+using namespace std;
+
+
+
+// The columns of the table for each side
+// SENS_PRICE is the unbumped price, SENS_GAMMA the second derivative in S, and the others the first derivatives in S, K, T, r, b, and sig
+// A call's columns are 0 to SENS_COLUMNS - 1 and a put's columns follow them
+enum SensitivityColumn {
+	SENS_PRICE,
+	SENS_DELTA,
+	SENS_GAMMA,
+	SENS_STRIKE,
+	SENS_EXPIRY,
+	SENS_RATE,
+	SENS_CARRY,
+	SENS_VEGA,
+	SENS_COLUMNS
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the SensitivityEngine class
+// For each row of a Matrix, the base point and an up and a down bump of each of S, K, T, r, b, and sig are laid out side by side,
+// so a block of rows is priced with one call of the batch kernel, which gives the call and the put of every point at once
+// The base price is shared by the central differences of every parameter and by gamma
+// Each bump is m_bump times the larger of the parameter and 1, and the results go into one table of rows x (2 * SENS_COLUMNS) doubles
+// Rows of PerpetualAmericanOptions are priced with the scalar kernels and have no expiry, so their SENS_EXPIRY columns are 0
+class SensitivityEngine {
+private:
+
+	// The relative size of the bumps
+	double m_bump;
+
+	// The table, row by row
+	std::vector<double> m_table;
+	int m_rows;
+
+	// Fills the table for Matrices of EuropeanOptions and of PerpetualAmericanOptions
+	void ComputeEO(const Matrix& matrix);
+	void ComputePAO(const Matrix& matrix);
+
+public:
+
+	// Default constructor
+	// Bumps of 1e-4
+	SensitivityEngine();
+
+	// Parameter constructor with the relative size of the bumps
+	SensitivityEngine(double bump);
+
+	// Destructor
+	virtual ~SensitivityEngine();
+
+	// Copy constructor
+	SensitivityEngine(const SensitivityEngine& source);
+
+	// Assignment operator
+	SensitivityEngine& operator = (const SensitivityEngine& source);
+
+	// Computes the table of a Matrix
+	void Compute(const Matrix& matrix);
+
+	// Returns the number of rows of the table
+	int Rows() const;
+
+	// Returns a column of a row for the call or the put
+	// Throws an OutOfBoundsException if the row or the column is out of bounds
+	double Call(const int& row, const int& column) const;
+	double Put(const int& row, const int& column) const;
+
+	// Returns the whole table, with 2 * SENS_COLUMNS entries per row
+	const std::vector<double>& Table() const;
+
+	// Returns the name of a column
+	static std::string Name(const int& column);
+
+	// Outputs the table of one side
+	void OutputTable(const bool& call) const;
+
+};
+
+
+
+#endif
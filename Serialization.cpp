@@ -0,0 +1,466 @@
+// Objective: Implement the binary serialization and the BookSnapshot class
+
+// Include the necessary header files
+#include "Serialization.hpp"
+#include "EuropeanOption.hpp"
+#include "PerpetualAmericanOption.hpp"
+#include "Matrix.hpp"
+#include "Exception.hpp"
+#include "Kernels.hpp"
+#include <iostream>
+using namespace std;
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <climits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+
+// Writes a header
+static void WriteHeader(std::ostream& os, const unsigned int& kind, const unsigned long long& count) {
+
+	// The reserved field and the padding are written as zeros
+	SnapshotHeader header = {};
+
+	header.magic = SNAPSHOT_MAGIC;
+	header.version = SNAPSHOT_VERSION;
+	header.kind = kind;
+	header.count = count;
+
+	os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+
+// Reads a header and checks that it holds the expected kind of data
+// Returns the number of records that follow
+static unsigned long long ReadHeader(std::istream& is, const unsigned int& kind) {
+
+	SnapshotHeader header;
+
+	if (!is.read(reinterpret_cast<char*>(&header), sizeof(header))) throw SerializationException("the stream ended before the header");
+
+	if (header.magic != SNAPSHOT_MAGIC) throw SerializationException("the stream is not a snapshot or was written with another byte order");
+
+	if (header.version != SNAPSHOT_VERSION) throw SerializationException("the snapshot version is not supported");
+
+	if (header.kind != kind) throw SerializationException("the snapshot holds another kind of data");
+
+	return header.count;
+}
+
+
+// Reads one record
+static OptionRecord ReadRecord(std::istream& is) {
+
+	OptionRecord record;
+
+	if (!is.read(reinterpret_cast<char*>(&record), sizeof(record))) throw SerializationException("the stream ended before a record");
+
+	return record;
+}
+
+
+// Builds the record of a row of a Matrix
+static OptionRecord Record(const Vector& v) {
+
+	if (v.OptionStyle() == "EO") {
+		OptionRecord record = { v[0], v[1], v[2], v[3], v[4], v[5], v[6], RECORD_EO, 1 };
+		return record;
+	}
+
+	OptionRecord record = { v[0], v[1], 0, v[2], v[3], v[4], v[5], RECORD_PAO, 1 };
+	return record;
+}
+
+
+// Builds a row of a Matrix from its record
+static Vector ToVector(const OptionRecord& record) {
+
+	if (record.style == RECORD_EO) {
+		return Vector(record.S, EuropeanOption(record.K, record.T, record.r, record.b, record.sig, record.q));
+	}
+
+	if (record.style == RECORD_PAO) {
+		return Vector(record.S, PerpetualAmericanOption(record.K, record.r, record.b, record.sig, record.q));
+	}
+
+	throw SerializationException("a record has an unknown option style");
+}
+
+
+
+// Builds the record of a EuropeanOption with a spot price
+OptionRecord Record(const double& S, const EuropeanOption& option) {
+	OptionRecord record = { S, option.StrikePrice(), option.Expiry(), option.RiskFreeRate(), option.CostOfCarry(), option.Volatility(), option.Dividend(), RECORD_EO, option.OptionType() == "Call" };
+	return record;
+}
+
+
+// Builds the record of a PerpetualAmericanOption with a spot price
+OptionRecord Record(const double& S, const PerpetualAmericanOption& option) {
+	OptionRecord record = { S, option.StrikePrice(), 0, option.RiskFreeRate(), option.CostOfCarry(), option.Volatility(), option.Dividend(), RECORD_PAO, option.OptionType() == "Call" };
+	return record;
+}
+
+
+
+// Writes a EuropeanOption
+void Serialize(std::ostream& os, const EuropeanOption& option) {
+
+	OptionRecord record = Record(0.0, option);
+
+	WriteHeader(os, SNAPSHOT_EUROPEAN, 1);
+	os.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+
+// Writes a PerpetualAmericanOption
+void Serialize(std::ostream& os, const PerpetualAmericanOption& option) {
+
+	OptionRecord record = Record(0.0, option);
+
+	WriteHeader(os, SNAPSHOT_PERPETUAL, 1);
+	os.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+
+// Writes a Vector
+void Serialize(std::ostream& os, const Vector& v) {
+
+	OptionRecord record = Record(v);
+
+	WriteHeader(os, SNAPSHOT_VECTOR, 1);
+	os.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+
+// Writes a Matrix with one record per row
+void Serialize(std::ostream& os, const Matrix& m) {
+
+	WriteHeader(os, SNAPSHOT_MATRIX, m.GetSize());
+
+	for (int i = 0; i < m.GetSize(); ++i) {
+
+		OptionRecord record = Record(m[i]);
+
+		os.write(reinterpret_cast<const char*>(&record), sizeof(record));
+	}
+}
+
+
+
+// Reads a EuropeanOption
+EuropeanOption DeserializeEuropeanOption(std::istream& is) {
+
+	ReadHeader(is, SNAPSHOT_EUROPEAN);
+	OptionRecord record = ReadRecord(is);
+
+	EuropeanOption option(record.K, record.T, record.r, record.b, record.sig, record.q);
+
+	if (!record.call) {
+		option.Toggle();
+	}
+
+	return option;
+}
+
+
+// Reads a PerpetualAmericanOption
+PerpetualAmericanOption DeserializePerpetualAmericanOption(std::istream& is) {
+
+	ReadHeader(is, SNAPSHOT_PERPETUAL);
+	OptionRecord record = ReadRecord(is);
+
+	PerpetualAmericanOption option(record.K, record.r, record.b, record.sig, record.q);
+
+	if (!record.call) {
+		option.Toggle();
+	}
+
+	return option;
+}
+
+
+// Reads a Vector
+Vector DeserializeVector(std::istream& is) {
+	ReadHeader(is, SNAPSHOT_VECTOR);
+	return ToVector(ReadRecord(is));
+}
+
+
+// The most rows that DeserializeMatrix reserves before it reads them
+static const int MAX_RESERVED_ROWS = 1 << 16;
+
+
+// Reads a Matrix
+Matrix DeserializeMatrix(std::istream& is) {
+
+	unsigned long long count = ReadHeader(is, SNAPSHOT_MATRIX);
+
+	// The count comes from the stream, so only a bounded number of rows is reserved before the rows are actually read
+	std::vector<Vector> rows;
+	rows.reserve(min(count, (unsigned long long)(MAX_RESERVED_ROWS)));
+
+	for (unsigned long long i = 0; i < count; ++i) {
+		rows.push_back(ToVector(ReadRecord(is)));
+	}
+
+	return Matrix(rows);
+}
+
+
+
+// Writes a whole book of records to a snapshot file
+void WriteSnapshot(const std::string& path, const std::vector<OptionRecord>& records) {
+
+	std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+
+	if (!file) throw SerializationException("cannot open " + path + " for writing");
+
+	WriteHeader(file, SNAPSHOT_BOOK, records.size());
+
+	if (!records.empty()) {
+		file.write(reinterpret_cast<const char*>(&records[0]), records.size() * sizeof(OptionRecord));
+	}
+
+	if (!file) throw SerializationException("cannot write " + path);
+}
+
+// The arrays of one block of EuropeanOption records, and the index of each option in the records
+struct RecordBlock {
+	int n;
+	int index[RECORD_BLOCK];
+	double S[RECORD_BLOCK];
+	double K[RECORD_BLOCK];
+	double T[RECORD_BLOCK];
+	double r[RECORD_BLOCK];
+	double b[RECORD_BLOCK];
+	double sig[RECORD_BLOCK];
+	double first[RECORD_BLOCK];
+	double second[RECORD_BLOCK];
+	double third[RECORD_BLOCK];
+};
+
+
+// Gathers the EuropeanOption records of [first, last) into the block
+static void Gather(const OptionRecord* records, const int& first, const int& last, RecordBlock& block) {
+
+	block.n = 0;
+
+	for (int i = first; i < last; ++i) {
+
+		const OptionRecord& rec = records[i];
+
+		if (rec.style != RECORD_EO) continue;
+
+		int j = block.n++;
+
+		block.index[j] = i;
+		block.S[j] = rec.S;
+		block.K[j] = rec.K;
+		block.T[j] = rec.T;
+		block.r[j] = rec.r;
+		block.b[j] = rec.b;
+		block.sig[j] = rec.sig;
+	}
+}
+
+
+// Prices n records
+// The EuropeanOption records go through the batch kernels, which price the call and the put together, and the other records are priced one at a time
+void PriceRecords(const int& n, const OptionRecord* records, double* out) {
+
+	RecordBlock block;
+
+	for (int first = 0; first < n; first += RECORD_BLOCK) {
+
+		int last = min(n, first + RECORD_BLOCK);
+
+		Gather(records, first, last, block);
+		PriceBatch(block.n, block.S, block.K, block.T, block.r, block.b, block.sig, block.first, block.second);
+
+		for (int j = 0; j < block.n; ++j) {
+			out[block.index[j]] = records[block.index[j]].call ? block.first[j] : block.second[j];
+		}
+
+		for (int i = first; i < last; ++i) {
+
+			const OptionRecord& rec = records[i];
+
+			if (rec.style == RECORD_PAO) {
+				out[i] = rec.call ? PerpetualCall<double>(rec.S, rec.K, rec.r, rec.b, rec.sig) : PerpetualPut<double>(rec.S, rec.K, rec.r, rec.b, rec.sig);
+			}
+
+			else if (rec.style != RECORD_EO) {
+				out[i] = 0;
+			}
+		}
+	}
+}
+
+
+// Computes the deltas and gammas of n records
+void GreeksRecords(const int& n, const OptionRecord* records, double* delta, double* gamma) {
+
+	RecordBlock block;
+
+	for (int first = 0; first < n; first += RECORD_BLOCK) {
+
+		int last = min(n, first + RECORD_BLOCK);
+
+		Gather(records, first, last, block);
+		GreeksBatch(block.n, block.S, block.K, block.T, block.r, block.b, block.sig, block.first, block.second, block.third);
+
+		for (int j = 0; j < block.n; ++j) {
+			delta[block.index[j]] = records[block.index[j]].call ? block.first[j] : block.second[j];
+			gamma[block.index[j]] = block.third[j];
+		}
+
+		for (int i = first; i < last; ++i) {
+
+			const OptionRecord& rec = records[i];
+
+			if (rec.style == RECORD_PAO) {
+				PerpetualGreeks<double>(rec.call != 0, rec.S, rec.K, rec.r, rec.b, rec.sig, delta[i], gamma[i]);
+			}
+
+			else if (rec.style != RECORD_EO) {
+				delta[i] = 0;
+				gamma[i] = 0;
+			}
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Parameter constructor
+// Maps the file and checks its header
+BookSnapshot::BookSnapshot(const std::string& path) : m_data(0), m_size(0), m_records(0), m_count(0), m_file(0), m_mapping(0) {
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+
+	if (file == INVALID_HANDLE_VALUE) throw SerializationException("cannot open " + path);
+
+	LARGE_INTEGER size;
+	GetFileSizeEx(file, &size);
+
+	HANDLE mapping = size.QuadPart > 0 ? CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0) : 0;
+
+	if (mapping == 0) {
+		CloseHandle(file);
+		throw SerializationException("cannot map " + path);
+	}
+
+	m_file = file;
+	m_mapping = mapping;
+	m_size = size.QuadPart;
+	m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+
+	if (fd == -1) throw SerializationException("cannot open " + path);
+
+	struct stat st;
+	fstat(fd, &st);
+
+	m_size = st.st_size;
+
+	void* data = m_size > 0 ? mmap(0, m_size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+
+	// The mapping stays valid after the file is closed
+	close(fd);
+
+	m_data = data == MAP_FAILED ? 0 : static_cast<const char*>(data);
+#endif
+
+	if (m_data == 0) {
+		Unmap();
+		throw SerializationException("cannot map " + path);
+	}
+
+	const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(m_data);
+
+	std::string reason;
+
+	if (m_size < sizeof(SnapshotHeader)) reason = "the file is too small to be a snapshot";
+
+	else if (header->magic != SNAPSHOT_MAGIC) reason = "the file is not a snapshot or was written with another byte order";
+
+	else if (header->version != SNAPSHOT_VERSION) reason = "the snapshot version is not supported";
+
+	else if (header->kind != SNAPSHOT_BOOK) reason = "the snapshot does not hold a book";
+
+	// The count is compared with the number of records that fit in the file, since count * sizeof(OptionRecord) can overflow for a corrupt count
+	else if (header->count > (m_size - sizeof(SnapshotHeader)) / sizeof(OptionRecord)) reason = "the file is shorter than its records";
+
+	else if (header->count > (unsigned long long)(INT_MAX)) reason = "the snapshot has more records than can be indexed";
+
+	if (!reason.empty()) {
+		Unmap();
+		throw SerializationException(reason);
+	}
+
+	m_records = reinterpret_cast<const OptionRecord*>(m_data + sizeof(SnapshotHeader));
+	m_count = header->count;
+}
+
+
+// Destructor
+// Unmaps the file
+BookSnapshot::~BookSnapshot() {
+	Unmap();
+}
+
+
+// Releases the mapping and the handles
+void BookSnapshot::Unmap() {
+
+#ifdef _WIN32
+	if (m_data != 0) UnmapViewOfFile(m_data);
+	if (m_mapping != 0) CloseHandle(m_mapping);
+	if (m_file != 0) CloseHandle(m_file);
+#else
+	if (m_data != 0) munmap(const_cast<char*>(m_data), m_size);
+#endif
+
+	m_data = 0;
+	m_mapping = 0;
+	m_file = 0;
+}
+
+
+// Returns the number of records
+int BookSnapshot::Count() const {
+	return m_count;
+}
+
+
+// Returns a record
+// Throws an OutOfBoundsException if the index is out of bounds
+const OptionRecord& BookSnapshot::operator [] (int index) const {
+
+	if (index < 0 || index >= m_count) throw OutOfBoundsException(index);
+
+	return m_records[index];
+}
+
+
+// Prices every record into out straight from the mapping
+void BookSnapshot::Price(double* out) const {
+	PriceRecords(m_count, m_records, out);
+}
@@ -0,0 +1,155 @@
+// Objective: Create the binary serialization of the option classes, the Vector and Matrix classes, and memory-mapped book snapshots
+
+// Ensure no errors if the header file is used twice
+#ifndef SERIALIZATION_HPP
+#define SERIALIZATION_HPP
+
+// Include header files
+#include "EuropeanOption.hpp"
+#include "PerpetualAmericanOption.hpp"
+#include "Matrix.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+
+// Every binary file starts with a SnapshotHeader followed by count OptionRecords
+// The version is increased whenever the layout of the header or of a record changes, and readers reject versions that they do not know
+// The values are stored in the byte order of the machine that wrote them, and the magic number is used to detect a different byte order
+const unsigned int SNAPSHOT_MAGIC = 0x46435342;
+const unsigned int SNAPSHOT_VERSION = 2;
+
+
+// What a binary file holds
+enum SnapshotKind {
+	SNAPSHOT_EUROPEAN = 1,
+	SNAPSHOT_PERPETUAL = 2,
+	SNAPSHOT_VECTOR = 3,
+	SNAPSHOT_MATRIX = 4,
+	SNAPSHOT_BOOK = 5
+};
+
+
+// The style of the option of a record, matching the styles of the Vector class
+enum RecordStyle {
+	RECORD_EO = 1,
+	RECORD_PAO = 2
+};
+
+
+// Create the SnapshotHeader struct
+// The header is padded to 64 bytes so that the records after it start on a cache line in a mapped snapshot
+struct SnapshotHeader {
+	unsigned int magic;
+	unsigned int version;
+	unsigned int kind;
+	unsigned int reserved;
+	unsigned long long count;
+	unsigned char padding[40];
+};
+
+
+// Create the OptionRecord struct
+// One record holds one option with its spot price, or one row of a Matrix
+// T is 0 for a PerpetualAmericanOption, and S is 0 for an option that is serialized on its own
+// The record is 64 bytes so that records never straddle a cache line in a mapped snapshot
+struct OptionRecord {
+	double S;
+	double K;
+	double T;
+	double r;
+	double b;
+	double sig;
+	double q;
+	unsigned int style;
+	unsigned int call;
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader must be 64 bytes");
+static_assert(sizeof(OptionRecord) == 64, "OptionRecord must be 64 bytes");
+
+
+
+// Global functions that build the record of an option with a spot price
+OptionRecord Record(const double& S, const EuropeanOption& option);
+OptionRecord Record(const double& S, const PerpetualAmericanOption& option);
+
+// Global functions that write an option, a Vector, or a Matrix to a binary stream
+void Serialize(std::ostream& os, const EuropeanOption& option);
+void Serialize(std::ostream& os, const PerpetualAmericanOption& option);
+void Serialize(std::ostream& os, const Vector& v);
+void Serialize(std::ostream& os, const Matrix& m);
+
+// Global functions that read an option, a Vector, or a Matrix back from a binary stream
+// Each throws a SerializationException if the stream does not hold the expected kind of data
+EuropeanOption DeserializeEuropeanOption(std::istream& is);
+PerpetualAmericanOption DeserializePerpetualAmericanOption(std::istream& is);
+Vector DeserializeVector(std::istream& is);
+Matrix DeserializeMatrix(std::istream& is);
+
+// A global function that writes a whole book of records to a snapshot file
+// Throws a SerializationException if the file cannot be written
+void WriteSnapshot(const std::string& path, const std::vector<OptionRecord>& records);
+
+// The EuropeanOption records are gathered into arrays of at most RECORD_BLOCK options and priced with the batch kernels
+const int RECORD_BLOCK = 256;
+
+// Global functions that price n records, and that compute their deltas and gammas
+// Records of an unknown style are given 0
+void PriceRecords(const int& n, const OptionRecord* records, double* out);
+void GreeksRecords(const int& n, const OptionRecord* records, double* delta, double* gamma);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the BookSnapshot class
+// A BookSnapshot maps a snapshot file into memory read-only, so the records are used in place without being read or parsed
+// The pages are loaded by the operating system as they are touched, so opening a snapshot takes the same time for any size of book
+class BookSnapshot {
+private:
+
+	// The mapped file
+	const char* m_data;
+	std::size_t m_size;
+
+	// The records of the book inside the mapping
+	const OptionRecord* m_records;
+	int m_count;
+
+	// The handles of the file and of the mapping on Windows
+	void* m_file;
+	void* m_mapping;
+
+	// BookSnapshots own their mapping and cannot be copied
+	BookSnapshot(const BookSnapshot& source);
+	BookSnapshot& operator = (const BookSnapshot& source);
+
+	// Releases the mapping and the handles
+	void Unmap();
+
+public:
+
+	// Parameter constructor
+	// Maps the snapshot file and checks its header, throwing a SerializationException if it is not a snapshot of this version
+	BookSnapshot(const std::string& path);
+
+	// Destructor
+	// Unmaps the file
+	virtual ~BookSnapshot();
+
+	// Returns the number of records
+	int Count() const;
+
+	// Returns a record
+	const OptionRecord& operator [] (int index) const;
+
+	// Prices every record into out, which must hold Count() entries
+	void Price(double* out) const;
+
+};
+
+
+
+#endif
@@ -0,0 +1,403 @@
+// Objective: Implement the NUMA topology and the ShardedBook class
+
+// Include the necessary header files
+#include "ShardedBook.hpp"
+#include "Serialization.hpp"
+#include <iostream>
+using namespace std;
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+
+// The size of the pages that the interleaved layout deals round the nodes
+static const std::size_t PAGE = 4096;
+
+
+// Returns the size of a block of bytes rounded up to whole pages
+static std::size_t PageBytes(const std::size_t& bytes) {
+	return (max(bytes, std::size_t(1)) + PAGE - 1) / PAGE * PAGE;
+}
+
+
+// Allocates a block of new pages straight from the operating system, or returns 0 if it cannot
+// The heap can hand back pages that were already touched, and so already placed on some node, but mapped pages are only placed when they are first written
+static void* AllocatePages(const std::size_t& bytes) {
+
+#ifdef _WIN32
+	return VirtualAlloc(0, PageBytes(bytes), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+	void* block = mmap(0, PageBytes(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	return block == MAP_FAILED ? 0 : block;
+#endif
+}
+
+
+// Frees a block of bytes from AllocatePages
+static void FreePages(void* block, const std::size_t& bytes) {
+
+	if (block == 0) return;
+
+#ifdef _WIN32
+	VirtualFree(block, 0, MEM_RELEASE);
+#else
+	munmap(block, PageBytes(bytes));
+#endif
+}
+
+
+// Returns the numbers of a list such as "0-3,8-11", which is how the kernel lists both cores and nodes
+static std::vector<int> NumberList(const std::string& text) {
+
+	std::vector<int> cpus;
+	std::stringstream ranges(text);
+	std::string range;
+
+	while (std::getline(ranges, range, ',')) {
+
+		int first = 0, last = 0;
+		std::size_t dash = range.find('-');
+
+		first = std::atoi(range.c_str());
+		last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+
+		for (int cpu = first; cpu <= last; ++cpu) {
+			cpus.push_back(cpu);
+		}
+	}
+
+	return cpus;
+}
+
+
+// Returns the NUMA nodes of the machine
+// Only the cores that this process may run on are kept, and nodes without such cores are dropped
+std::vector<NumaNode> NumaNodes() {
+
+	std::vector<NumaNode> nodes;
+
+#ifdef __linux__
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	sched_getaffinity(0, sizeof(allowed), &allowed);
+
+	std::ifstream online("/sys/devices/system/node/online");
+	std::string list;
+	std::getline(online, list);
+
+	std::vector<int> ids = NumberList(list);
+
+	for (std::size_t n = 0; n < ids.size(); ++n) {
+
+		int id = ids[n];
+		std::ifstream file(("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist").c_str());
+
+		if (!file) continue;
+
+		std::string text;
+		std::getline(file, text);
+
+		NumaNode node = { id, std::vector<int>() };
+		std::vector<int> cpus = NumberList(text);
+
+		for (std::size_t i = 0; i < cpus.size(); ++i) {
+			if (cpus[i] < CPU_SETSIZE && CPU_ISSET(cpus[i], &allowed)) {
+				node.cpus.push_back(cpus[i]);
+			}
+		}
+
+		if (!node.cpus.empty()) {
+			nodes.push_back(node);
+		}
+	}
+#endif
+
+	if (nodes.empty()) {
+
+		NumaNode node = { 0, std::vector<int>() };
+
+		for (int cpu = 0; cpu < max(1, int(std::thread::hardware_concurrency())); ++cpu) {
+			node.cpus.push_back(cpu);
+		}
+
+		nodes.push_back(node);
+	}
+
+	return nodes;
+}
+
+
+// Pins the calling thread to a core
+static void Pin(const int& cpu) {
+
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Parameter constructor
+// Each node gets a share of the book in proportion to its cores, and each core an equal part of the share of its node
+ShardedBook::ShardedBook(const std::vector<OptionRecord>& records, NumaLayout layout) : m_nodes(NumaNodes()), m_layout(layout), m_ranges(), m_count(records.size()),
+	m_records(0), m_values(0), m_source(records.data()), m_workers(), m_job(JOB_NONE), m_generation(0), m_finished(0) {
+
+	int cores = 0;
+
+	for (std::size_t k = 0; k < m_nodes.size(); ++k) {
+		cores += m_nodes[k].cpus.size();
+	}
+
+	int first = 0, core = 0;
+
+	for (std::size_t k = 0; k < m_nodes.size(); ++k) {
+
+		for (std::size_t c = 0; c < m_nodes[k].cpus.size(); ++c) {
+
+			++core;
+
+			int last = int((long long)m_count * core / cores);
+
+			Range range = { int(k), m_nodes[k].cpus[c], first, last - first, 0, 0 };
+			m_ranges.push_back(range);
+
+			first = last;
+		}
+	}
+
+	// The pages of a new block are not touched, so they are placed by the workers that fill them
+	if (m_layout == NUMA_INTERLEAVED) {
+
+		m_records = static_cast<OptionRecord*>(AllocatePages(m_count * sizeof(OptionRecord)));
+		m_values = static_cast<double*>(AllocatePages(m_count * sizeof(double)));
+
+		if (m_records == 0 || m_values == 0) {
+			this->Release();
+			throw std::bad_alloc();
+		}
+
+		for (std::size_t w = 0; w < m_ranges.size(); ++w) {
+			m_ranges[w].records = m_records + m_ranges[w].first;
+			m_ranges[w].values = m_values + m_ranges[w].first;
+		}
+	}
+
+	for (std::size_t w = 0; w < m_ranges.size(); ++w) {
+		m_workers.push_back(std::thread(&ShardedBook::Work, this, int(w)));
+	}
+
+	this->Run(JOB_FILL);
+
+	m_source = 0;
+
+	// A worker that could not allocate its range leaves it null
+	for (std::size_t w = 0; w < m_ranges.size(); ++w) {
+		if (m_ranges[w].records == 0 || m_ranges[w].values == 0) {
+			this->Release();
+			throw std::bad_alloc();
+		}
+	}
+}
+
+
+// Destructor
+ShardedBook::~ShardedBook() {
+	this->Release();
+}
+
+
+// Stops the workers and frees the memory
+void ShardedBook::Release() {
+
+	if (!m_workers.empty()) {
+		this->Run(JOB_EXIT);
+	}
+
+	for (std::size_t w = 0; w < m_workers.size(); ++w) {
+		m_workers[w].join();
+	}
+
+	m_workers.clear();
+
+	if (m_layout == NUMA_LOCAL) {
+
+		for (std::size_t w = 0; w < m_ranges.size(); ++w) {
+			FreePages(m_ranges[w].records, m_ranges[w].count * sizeof(OptionRecord));
+			FreePages(m_ranges[w].values, m_ranges[w].count * sizeof(double));
+		}
+	}
+
+	FreePages(m_records, m_count * sizeof(OptionRecord));
+	FreePages(m_values, m_count * sizeof(double));
+
+	m_ranges.clear();
+	m_records = 0;
+	m_values = 0;
+}
+
+
+// Returns the number of options, of nodes, and of workers
+int ShardedBook::Count() const {
+	return m_count;
+}
+
+int ShardedBook::Nodes() const {
+	return m_nodes.size();
+}
+
+int ShardedBook::Workers() const {
+	return m_ranges.size();
+}
+
+
+// Prices every option and merges the values of the workers in the order of the book
+void ShardedBook::Price(double* out) {
+
+	this->Run(JOB_PRICE);
+
+	for (std::size_t w = 0; w < m_ranges.size(); ++w) {
+		if (m_ranges[w].count > 0) {
+			std::memcpy(out + m_ranges[w].first, m_ranges[w].values, m_ranges[w].count * sizeof(double));
+		}
+	}
+}
+
+
+// Hands a job to every worker and waits until they have all run it
+void ShardedBook::Run(const Job& job) {
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	m_job = job;
+	m_finished = 0;
+	++m_generation;
+
+	m_start.notify_all();
+
+	while (m_finished < int(m_workers.size())) {
+		m_done.wait(lock);
+	}
+}
+
+
+// The worker loop
+// The worker pins itself to its core before it touches any memory
+void ShardedBook::Work(const int& index) {
+
+	Pin(m_ranges[index].cpu);
+
+	unsigned long long seen = 0;
+
+	while (true) {
+
+		Job job;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			while (m_generation == seen) {
+				m_start.wait(lock);
+			}
+
+			seen = m_generation;
+			job = m_job;
+		}
+
+		Range& range = m_ranges[index];
+
+		if (job == JOB_FILL) {
+			this->Fill(index);
+		}
+
+		else if (job == JOB_PRICE && range.count > 0) {
+			PriceRecords(range.count, range.records, range.values);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			if (++m_finished == int(m_workers.size())) {
+				m_done.notify_all();
+			}
+		}
+
+		if (job == JOB_EXIT) return;
+	}
+}
+
+
+// Fills the memory of a worker
+// In the local layout the worker allocates its own range, so every page of the range is first written on the node of the worker
+// In the interleaved layout page p of each block is written by a worker of node p % nodes, whatever range the page belongs to
+void ShardedBook::Fill(const int& index) {
+
+	Range& range = m_ranges[index];
+
+	if (m_layout == NUMA_LOCAL) {
+
+		range.records = static_cast<OptionRecord*>(AllocatePages(range.count * sizeof(OptionRecord)));
+		range.values = static_cast<double*>(AllocatePages(range.count * sizeof(double)));
+
+		// The constructor sees the null range and throws once every worker has finished
+		if (range.records == 0 || range.values == 0) {
+			return;
+		}
+
+		if (range.count > 0) {
+			std::memcpy(range.records, m_source + range.first, range.count * sizeof(OptionRecord));
+			std::memset(range.values, 0, range.count * sizeof(double));
+		}
+
+		return;
+	}
+
+	// The workers of a node share its pages in turn
+	int nodes = m_nodes.size();
+	int peers = m_nodes[range.node].cpus.size();
+	int rank = 0;
+
+	for (int w = 0; w < index; ++w) {
+		rank += m_ranges[w].node == range.node;
+	}
+
+	char* records = reinterpret_cast<char*>(m_records);
+	char* values = reinterpret_cast<char*>(m_values);
+	const char* source = reinterpret_cast<const char*>(m_source);
+
+	std::size_t record_bytes = m_count * sizeof(OptionRecord);
+	std::size_t value_bytes = m_count * sizeof(double);
+
+	for (std::size_t page = 0; page * PAGE < record_bytes; ++page) {
+		if (int(page % nodes) == range.node && int(page / nodes % peers) == rank) {
+			std::memcpy(records + page * PAGE, source + page * PAGE, min(PAGE, record_bytes - page * PAGE));
+		}
+	}
+
+	for (std::size_t page = 0; page * PAGE < value_bytes; ++page) {
+		if (int(page % nodes) == range.node && int(page / nodes % peers) == rank) {
+			std::memset(values + page * PAGE, 0, min(PAGE, value_bytes - page * PAGE));
+		}
+	}
+}
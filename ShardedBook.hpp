@@ -0,0 +1,131 @@
+// Objective: Create the ShardedBook class that splits a book of options across the NUMA nodes and prices it with pinned threads
+
+// Ensure no errors if the header file is used twice
+#ifndef SHARDEDBOOK_HPP
+#define SHARDEDBOOK_HPP
+
+// Include header files
+#include "Serialization.hpp"
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+using namespace std;
+
+
+
+// Create the NumaNode struct
+// A NUMA node and the cores of the node that this process may run on
+struct NumaNode {
+	int id;
+	std::vector<int> cpus;
+};
+
+
+// A global function that returns the NUMA nodes of the machine
+// On Linux the nodes are read from /sys/devices/system/node, and elsewhere, or when nothing can be read, every core is put in one node
+std::vector<NumaNode> NumaNodes();
+
+
+// How the memory of a ShardedBook is placed
+// NUMA_LOCAL: the options of each thread are on the node of the thread
+// NUMA_INTERLEAVED: the pages of the book go round the nodes, so most threads read most of their options from another node
+enum NumaLayout {
+	NUMA_LOCAL,
+	NUMA_INTERLEAVED
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the ShardedBook class
+// The book is cut into one shard per node, in proportion to the cores of the node, and each shard into one range per core
+// Every core gets a worker thread pinned to it, which lives as long as the ShardedBook
+// Linux places a page on the node of the thread that writes it first, so in the local layout each worker allocates and fills its own range,
+// and in the interleaved layout the workers fill the pages of one block in turn
+// Price() has every worker price its range into a buffer of its own, and then merges the buffers into the output
+class ShardedBook {
+private:
+
+	// The range of the book that one worker prices, and the memory it reads and writes
+	struct Range {
+		int node;
+		int cpu;
+		int first;
+		int count;
+		OptionRecord* records;
+		double* values;
+	};
+
+	// The jobs of the workers
+	enum Job {
+		JOB_NONE,
+		JOB_FILL,
+		JOB_PRICE,
+		JOB_EXIT
+	};
+
+	// The nodes, the layout, and the ranges
+	std::vector<NumaNode> m_nodes;
+	NumaLayout m_layout;
+	std::vector<Range> m_ranges;
+	int m_count;
+
+	// The blocks of the interleaved layout
+	OptionRecord* m_records;
+	double* m_values;
+
+	// The book while it is being filled
+	const OptionRecord* m_source;
+
+	// The workers and the job they are running
+	std::vector<std::thread> m_workers;
+	Job m_job;
+	unsigned long long m_generation;
+	int m_finished;
+	std::mutex m_mutex;
+	std::condition_variable m_start;
+	std::condition_variable m_done;
+
+	// The worker loop
+	void Work(const int& index);
+
+	// Hands a job to every worker and waits until they have all run it
+	void Run(const Job& job);
+
+	// Fills the memory of a worker
+	void Fill(const int& index);
+
+	// Stops the workers and frees the memory of the shards
+	void Release();
+
+	// ShardedBooks own their workers and memory and cannot be copied
+	ShardedBook(const ShardedBook& source);
+	ShardedBook& operator = (const ShardedBook& source);
+
+public:
+
+	// Parameter constructor with the book and the layout
+	// The workers are started and fill the shards before the constructor returns
+	// The shards are mapped straight from the operating system, so their pages are new and placed by the worker that first writes them
+	// Throws a std::bad_alloc if the memory of a shard cannot be mapped
+	ShardedBook(const std::vector<OptionRecord>& records, NumaLayout layout);
+
+	// Destructor
+	// Stops the workers and frees the shards
+	virtual ~ShardedBook();
+
+	// Returns the number of options, of nodes, and of workers
+	int Count() const;
+	int Nodes() const;
+	int Workers() const;
+
+	// Prices every option into out, which must hold Count() entries, in the order of the book
+	void Price(double* out);
+
+};
+
+
+
+#endif
@@ -0,0 +1,410 @@
+// Objective: Implement the SharedRing class
+
+// Include the necessary header files
+#include "SharedRing.hpp"
+#include "Serialization.hpp"
+#include "Exception.hpp"
+#include <iostream>
+using namespace std;
+#include <string>
+#include <vector>
+#include <new>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <exception>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+
+// Parameter constructor
+// The creator sizes the object and builds the rings in it, and an opener checks that it holds rings of this version
+SharedRing::SharedRing(const std::string& name, bool create) : m_name(name), m_owner(create), m_ring(0), m_mapping(0) {
+
+	void* data = 0;
+
+#ifdef _WIN32
+	std::string local = "Local\\" + (name.empty() || name[0] != '/' ? name : name.substr(1));
+
+	HANDLE mapping = create ? CreateFileMappingA(INVALID_HANDLE_VALUE, 0, PAGE_READWRITE, 0, sizeof(RingLayout), local.c_str()) : OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, local.c_str());
+
+	if (mapping == 0) throw SharedMemoryException("cannot " + std::string(create ? "create " : "open ") + name);
+
+	m_mapping = mapping;
+	data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(RingLayout));
+#else
+	if (create) {
+		shm_unlink(name.c_str());
+	}
+
+	int fd = shm_open(name.c_str(), create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0600);
+
+	if (fd == -1) throw SharedMemoryException("cannot " + std::string(create ? "create " : "open ") + name);
+
+	struct stat st;
+
+	if ((create && ftruncate(fd, sizeof(RingLayout)) == -1) || fstat(fd, &st) == -1 || std::size_t(st.st_size) < sizeof(RingLayout)) {
+
+		close(fd);
+
+		if (create) {
+			shm_unlink(name.c_str());
+		}
+
+		throw SharedMemoryException(name + " does not hold the rings");
+	}
+
+	data = mmap(0, sizeof(RingLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (data == MAP_FAILED) {
+		data = 0;
+	}
+#endif
+
+	if (data == 0) {
+		this->Unmap();
+		throw SharedMemoryException("cannot map " + name);
+	}
+
+	m_ring = static_cast<RingLayout*>(data);
+
+	if (create) {
+
+		new (m_ring) RingLayout;
+
+		m_ring->version = RING_VERSION;
+		m_ring->clients = 0;
+		m_ring->head = 0;
+		m_ring->tail = 0;
+
+		for (int i = 0; i < REQUEST_SLOTS; ++i) {
+			m_ring->requests[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		for (int c = 0; c < RING_CLIENTS; ++c) {
+			m_ring->responses[c].head = 0;
+			m_ring->responses[c].dropped = 0;
+			m_ring->responses[c].tail = 0;
+		}
+
+		std::atomic_thread_fence(std::memory_order_release);
+		m_ring->magic = RING_MAGIC;
+	}
+
+	else if (m_ring->magic != RING_MAGIC || m_ring->version != RING_VERSION) {
+		this->Unmap();
+		throw SharedMemoryException(name + " does not hold rings of this version");
+	}
+}
+
+
+// Destructor
+SharedRing::~SharedRing() {
+	this->Unmap();
+}
+
+
+// Unmaps the rings, and removes the shared memory object when this process created it
+void SharedRing::Unmap() {
+
+#ifdef _WIN32
+	if (m_ring != 0) UnmapViewOfFile(m_ring);
+	if (m_mapping != 0) CloseHandle(m_mapping);
+#else
+	if (m_ring != 0) munmap(m_ring, sizeof(RingLayout));
+	if (m_owner) shm_unlink(m_name.c_str());
+#endif
+
+	m_ring = 0;
+	m_mapping = 0;
+	m_owner = false;
+}
+
+
+// Takes up to max ready requests, prices them, and writes their responses
+// Only one process serves a ring, so the tail is never shared
+int SharedRing::Serve(const int& max) {
+
+	m_records.clear();
+	m_clients.clear();
+	m_tags.clear();
+
+	// Only grows the buffers the first time a larger max is given
+	m_records.reserve(max);
+	m_clients.reserve(max);
+	m_tags.reserve(max);
+
+	unsigned long long tail = m_ring->tail;
+
+	while (int(m_records.size()) < max) {
+
+		RingRequest& slot = m_ring->requests[tail % REQUEST_SLOTS];
+
+		if (slot.sequence.load(std::memory_order_acquire) != tail + 1) break;
+
+		m_records.push_back(slot.record);
+		m_clients.push_back(slot.client);
+		m_tags.push_back(slot.tag);
+
+		// Hand the slot back to the producers for the next lap of the ring
+		slot.sequence.store(tail + REQUEST_SLOTS, std::memory_order_release);
+		++tail;
+	}
+
+	m_ring->tail = tail;
+
+	int n = m_records.size();
+
+	if (n == 0) return 0;
+
+	m_prices.resize(n);
+	PriceRecords(n, &m_records[0], &m_prices[0]);
+
+	for (int i = 0; i < n; ++i) {
+
+		if (m_clients[i] >= unsigned(RING_CLIENTS)) continue;
+
+		ResponseRing& ring = m_ring->responses[m_clients[i]];
+		unsigned long long head = ring.head.load(std::memory_order_relaxed);
+
+		// The client has more than RESPONSE_SLOTS requests in flight or has stopped reading, so its response is dropped rather than waited on
+		if (head - ring.tail.load(std::memory_order_acquire) >= unsigned(RESPONSE_SLOTS)) {
+			ring.dropped.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		RingResponse& slot = ring.slots[head % RESPONSE_SLOTS];
+		slot.tag = m_tags[i];
+		slot.value = m_prices[i];
+
+		ring.head.store(head + 1, std::memory_order_release);
+	}
+
+	return n;
+}
+
+
+// Serves requests until running becomes false
+void SharedRing::Run(const std::atomic<bool>& running, const int& max) {
+
+	while (running) {
+
+		if (this->Serve(max) == 0) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+
+// Returns a new client number
+int SharedRing::Attach() {
+
+	unsigned int client = m_ring->clients.fetch_add(1);
+
+	if (client >= unsigned(RING_CLIENTS)) throw SharedMemoryException("every client of " + m_name + " is taken");
+
+	return client;
+}
+
+
+// Writes a request
+// The producers claim positions by moving the head, and a position is free when its slot's sequence equals it
+bool SharedRing::Submit(const int& client, const unsigned int& tag, const OptionRecord& record) {
+
+	if (client < 0 || unsigned(client) >= min(m_ring->clients.load(), unsigned(RING_CLIENTS))) throw OutOfBoundsException(client);
+
+	unsigned long long head = m_ring->head.load(std::memory_order_relaxed);
+
+	while (true) {
+
+		RingRequest& slot = m_ring->requests[head % REQUEST_SLOTS];
+		long long diff = (long long)slot.sequence.load(std::memory_order_acquire) - (long long)head;
+
+		if (diff == 0) {
+
+			if (m_ring->head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+
+				slot.client = client;
+				slot.tag = tag;
+				slot.record = record;
+				slot.sequence.store(head + 1, std::memory_order_release);
+
+				return true;
+			}
+		}
+
+		// The slot still holds a request from the previous lap, so the ring is full
+		else if (diff < 0) {
+			return false;
+		}
+
+		else {
+			head = m_ring->head.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+
+// Reads a response
+bool SharedRing::Receive(const int& client, unsigned int& tag, double& value) {
+
+	if (client < 0 || unsigned(client) >= min(m_ring->clients.load(), unsigned(RING_CLIENTS))) throw OutOfBoundsException(client);
+
+	ResponseRing& ring = m_ring->responses[client];
+	unsigned long long tail = ring.tail.load(std::memory_order_relaxed);
+
+	if (tail == ring.head.load(std::memory_order_acquire)) return false;
+
+	const RingResponse& slot = ring.slots[tail % RESPONSE_SLOTS];
+	tag = slot.tag;
+	value = slot.value;
+
+	ring.tail.store(tail + 1, std::memory_order_release);
+
+	return true;
+}
+
+
+// Returns the number of responses of a client that the server dropped
+unsigned long long SharedRing::Dropped(const int& client) const {
+
+	if (client < 0 || unsigned(client) >= min(m_ring->clients.load(), unsigned(RING_CLIENTS))) throw OutOfBoundsException(client);
+
+	return m_ring->responses[client].dropped.load(std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Returns the steady clock in seconds
+static double Now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+// Measures the round trip of batches of requests through a SharedRing
+// The producers are threads of this process, but they only share the mapping with the server, as separate processes would
+void RingBenchmark(const int& producers, const int& batch, const int& rounds) {
+
+	if (rounds <= 0) throw OutOfBoundsException(rounds);
+
+	int n = max(1, min(batch, RESPONSE_SLOTS));
+	int p = max(1, min(producers, RING_CLIENTS));
+
+	SharedRing server("/bscf-ring-bench", true);
+	std::atomic<bool> running(true);
+
+	std::thread consumer([&server, &running]() { server.Run(running, REQUEST_SLOTS); });
+
+	std::vector<std::vector<double>> latencies(p);
+	std::vector<int> mismatches(p, 0);
+	std::vector<std::exception_ptr> errors(p);
+	std::vector<std::thread> threads;
+
+	double start = Now();
+
+	for (int t = 0; t < p; ++t) {
+
+		threads.push_back(std::thread([t, n, rounds, &latencies, &mismatches, &errors]() {
+
+			try {
+
+				SharedRing ring("/bscf-ring-bench", false);
+				int client = ring.Attach();
+
+				std::mt19937 gen(t + 1);
+				std::uniform_real_distribution<double> spot(80, 120), expiry(0.1, 2), vol(0.1, 0.5);
+
+				std::vector<OptionRecord> records(n);
+				std::vector<double> expected(n), values(n);
+
+				for (int k = 0; k < rounds; ++k) {
+
+					for (int i = 0; i < n; ++i) {
+						OptionRecord rec = { spot(gen), 100, expiry(gen), 0.05, 0.03, vol(gen), 0, i % 8 == 7 ? unsigned(RECORD_PAO) : unsigned(RECORD_EO), unsigned(i % 2) };
+						records[i] = rec;
+					}
+
+					double begin = Now();
+
+					for (int i = 0; i < n; ++i) {
+						while (!ring.Submit(client, i, records[i])) {
+							std::this_thread::yield();
+						}
+					}
+
+					unsigned int tag;
+					double value;
+
+					for (int received = 0; received < n; ) {
+
+						if (ring.Receive(client, tag, value)) {
+							values[tag] = value;
+							++received;
+						}
+
+						else {
+							std::this_thread::yield();
+						}
+					}
+
+					latencies[t].push_back((Now() - begin) * 1e9);
+
+					PriceRecords(n, &records[0], &expected[0]);
+
+					for (int i = 0; i < n; ++i) {
+						mismatches[t] += values[i] != expected[i];
+					}
+				}
+			}
+			catch (...) {
+				errors[t] = std::current_exception();
+			}
+		}));
+	}
+
+	for (int t = 0; t < p; ++t) {
+		threads[t].join();
+	}
+
+	double seconds = Now() - start;
+
+	running = false;
+	consumer.join();
+
+	std::vector<double> all;
+	int wrong = 0;
+
+	for (int t = 0; t < p; ++t) {
+
+		if (errors[t]) std::rethrow_exception(errors[t]);
+
+		all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+		wrong += mismatches[t];
+	}
+
+	std::sort(all.begin(), all.end());
+
+	int size = all.size();
+
+	if (size == 0) {
+		std::cout << "No round trips were measured" << endl;
+		return;
+	}
+
+	std::cout << p << " producers x " << rounds << " rounds of " << n << " requests through shared memory" << endl;
+	std::cout << "Requests/s: " << size * double(n) / seconds << '\t' << "Round trips/s: " << size / seconds << endl;
+	std::cout << "Round trip p50: " << all[size / 2] / 1e3 << " us" << '\t' << "p99: " << all[min(size - 1, int(0.99 * size))] / 1e3 << " us" << '\t' << "p999: " << all[min(size - 1, int(0.999 * size))] / 1e3 << " us" << endl;
+	std::cout << "Values that do not match the producers: " << wrong << endl;
+}
@@ -0,0 +1,151 @@
+// Objective: Create the SharedRing class that carries pricing requests and responses between processes through shared memory
+
+// Ensure no errors if the header file is used twice
+#ifndef SHAREDRING_HPP
+#define SHAREDRING_HPP
+
+// Include header files
+#include "Serialization.hpp"
+#include <iostream>
+#include <string>
+#include <atomic>
+using namespace std;
+#include <vector>
+
+
+
+// The size of the rings
+// Each client must keep at most RESPONSE_SLOTS requests in flight: the server never waits on a full response ring, and drops the responses that do not fit
+const unsigned int RING_MAGIC = 0x52435342;
+const unsigned int RING_VERSION = 2;
+const int REQUEST_SLOTS = 4096;
+const int RESPONSE_SLOTS = 4096;
+const int RING_CLIENTS = 16;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "the rings need lock-free 64-bit atomics to be shared between processes");
+
+
+// A slot of the request ring
+// sequence is the position of the slot when it is free for a producer, and that position + 1 when it holds a request for the server
+struct RingRequest {
+	std::atomic<unsigned long long> sequence;
+	unsigned int client;
+	unsigned int tag;
+	OptionRecord record;
+};
+
+
+// A slot of a response ring
+struct RingResponse {
+	unsigned int tag;
+	unsigned int reserved;
+	double value;
+};
+
+
+// The response ring of one client, written by the server and read by the client
+// head and tail are on their own cache lines so that the server and the client do not write to the same line
+// dropped counts the responses the server could not write because the ring was full, and is only written by the server
+struct ResponseRing {
+	alignas(64) std::atomic<unsigned long long> head;
+	std::atomic<unsigned long long> dropped;
+	alignas(64) std::atomic<unsigned long long> tail;
+	alignas(64) RingResponse slots[RESPONSE_SLOTS];
+};
+
+
+// The shared memory
+// The request ring has many producers and one consumer, and each response ring has one producer and one consumer
+struct RingLayout {
+	unsigned int magic;
+	unsigned int version;
+	std::atomic<unsigned int> clients;
+	alignas(64) std::atomic<unsigned long long> head;
+	alignas(64) unsigned long long tail;
+	alignas(64) RingRequest requests[REQUEST_SLOTS];
+	ResponseRing responses[RING_CLIENTS];
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Create the SharedRing class
+// The pricing process creates the shared memory object and serves it, and every client process opens the same name and attaches as a client
+// Clients write OptionRecords straight into the request ring, the server takes every ready request at once, prices them together with PriceRecords,
+// and writes each price into the response ring of its client with the tag that the client gave the request
+// No system call is made once the rings are mapped: an idle server or client yields its thread and polls again
+class SharedRing {
+private:
+
+	// The name of the shared memory object, and whether this process created it
+	std::string m_name;
+	bool m_owner;
+
+	// The mapping
+	RingLayout* m_ring;
+
+	// The requests taken by Serve, kept between calls so that serving does not allocate once they have grown to the largest batch
+	std::vector<OptionRecord> m_records;
+	std::vector<unsigned int> m_clients;
+	std::vector<unsigned int> m_tags;
+	std::vector<double> m_prices;
+
+	// The handle of the mapping on Windows
+	void* m_mapping;
+
+	// SharedRings own their mapping and cannot be copied
+	SharedRing(const SharedRing& source);
+	SharedRing& operator = (const SharedRing& source);
+
+	// Unmaps the rings, and removes the shared memory object when this process created it
+	void Unmap();
+
+public:
+
+	// Parameter constructor with the name of the shared memory object, which starts with '/'
+	// The server creates the object and the clients open it
+	// Throws a SharedMemoryException if the object cannot be created, opened, or mapped, or is not a ring of this version
+	SharedRing(const std::string& name, bool create);
+
+	// Destructor
+	// Unmaps the rings, and removes the shared memory object when this process created it
+	virtual ~SharedRing();
+
+	// Server side
+	// Takes up to max ready requests, prices them, and writes their responses
+	// A response that does not fit in the response ring of its client is dropped and counted, so one slow client cannot stall the others
+	// Returns the number of requests that were served
+	int Serve(const int& max);
+
+	// Serves requests until running becomes false
+	void Run(const std::atomic<bool>& running, const int& max);
+
+	// Client side
+	// Returns a new client number
+	// Client numbers are not reused, so a ring serves RING_CLIENTS attachments over its life
+	// Throws a SharedMemoryException when RING_CLIENTS clients are already attached
+	int Attach();
+
+	// Writes a request and returns false if the request ring is full
+	// Throws an OutOfBoundsException if the client is not attached
+	bool Submit(const int& client, const unsigned int& tag, const OptionRecord& record);
+
+	// Reads a response and returns false if there is none
+	// Throws an OutOfBoundsException if the client is not attached
+	bool Receive(const int& client, unsigned int& tag, double& value);
+
+	// Returns the number of responses of a client that the server dropped because its response ring was full
+	// Throws an OutOfBoundsException if the client is not attached
+	unsigned long long Dropped(const int& client) const;
+
+};
+
+
+// A global function that measures the round trip of batches of requests from several producer threads through a SharedRing served by another thread
+// Each producer submits batch requests, waits for the responses, checks them against PriceRecords, and repeats rounds times
+// Throws an OutOfBoundsException if rounds is not positive
+void RingBenchmark(const int& producers, const int& batch, const int& rounds);
+
+
+
+#endif
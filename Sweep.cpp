@@ -0,0 +1,272 @@
+// Objective: Implement the Sweep class
+
+// Include the necessary header files
+#include "Sweep.hpp"
+#include "Matrix.hpp"
+#include "Exception.hpp"
+#include "Kernels.hpp"
+#include "Instrumentation.hpp"
+#include <iostream>
+using namespace std;
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+
+
+// The number of rows generated and priced at a time, so the generated parameters stay in the L1 cache
+static const int SWEEP_BLOCK = 1024;
+
+
+
+// Default constructor
+Sweep::Sweep() : m_base(), m_index(0), m_start(0), m_step(0), m_count(0) {}
+
+
+// Returns the number of rows of the Matrix built with n increments
+// The Matrix adds a row for every integer i with 0 <= i < n after its first row, so a fractional n is rounded up and an n of 0 or less gives the first row only
+static int Rows(const double& n) {
+	return n > 0 ? int(ceil(n)) + 1 : 1;
+}
+
+
+// Parameter constructor for a EuropeanOption
+// index: the parameter of the option that is being incremented
+// b: the ending point of the increments
+// n: the number of increments, so the Sweep has the same rows as the Matrix, n + 1 when n is a positive integer
+// With n of 0 or less the Sweep only has the first row, and the step is 0 instead of the infinite step of (b - start) / 0
+Sweep::Sweep(EuropeanOption EO, double S, int index, double b, double n) : m_base(S, EO), m_index(index), m_start(0), m_step(0), m_count(Rows(n)) {
+	m_start = m_base[index];
+	m_step = n > 0 ? (b - m_start) / n : 0;
+}
+
+
+// Parameter constructor for a PerpetualAmericanOption
+Sweep::Sweep(PerpetualAmericanOption PAO, double S, int index, double b, double n) : m_base(S, PAO), m_index(index), m_start(0), m_step(0), m_count(Rows(n)) {
+	m_start = m_base[index];
+	m_step = n > 0 ? (b - m_start) / n : 0;
+}
+
+
+// Destructor
+Sweep::~Sweep() {}
+
+
+// Copy constructor
+Sweep::Sweep(const Sweep& source) : m_base(source.m_base), m_index(source.m_index), m_start(source.m_start), m_step(source.m_step), m_count(source.m_count) {}
+
+
+// Assignment operator
+Sweep& Sweep::operator = (const Sweep& source) {
+
+	if (this == &source) {
+		return *this;
+	}
+
+	m_base = source.m_base;
+	m_index = source.m_index;
+	m_start = source.m_start;
+	m_step = source.m_step;
+	m_count = source.m_count;
+
+	return *this;
+}
+
+
+
+// Returns row i, generated from the first row
+Vector Sweep::GetRow(const int& index) const {
+
+	Vector row(m_base);
+	row[m_index] = this->Value(index);
+
+	return row;
+}
+
+
+// Returns the swept parameter of row i
+double Sweep::Value(const int& index) const {
+
+	if (index < 0 || index >= m_count) throw OutOfBoundsException(index);
+
+	return m_start + index * m_step;
+}
+
+
+// Returns the number of rows
+int Sweep::GetSize() const {
+	return m_count;
+}
+
+
+
+// Prices every row and returns a tuple with a vector of calls and a vector of puts
+boost::tuple<vector<double>, vector<double>> Sweep::MatrixPricer() const {
+
+	vector<double> calls(m_count);
+	vector<double> puts(m_count);
+
+	if (m_count > 0) {
+		this->MatrixPricer(&calls[0], &puts[0]);
+	}
+
+	boost::tuple<vector<double>, vector<double>> tup(calls, puts);
+
+	return tup;
+}
+
+
+// Prices every row into caller-provided buffers
+void Sweep::MatrixPricer(double* calls, double* puts) const {
+	this->MatrixPricer(0, m_count, calls, puts);
+}
+
+
+// Prices the rows [first, first + count)
+// EuropeanOptions go through the sweep kernel of the index a block of swept values at a time, and PerpetualAmericanOptions through the scalar kernels
+// If it is necessary to add another derived options class, add another else if block for its style
+void Sweep::MatrixPricer(const int& first, const int& count, double* calls, double* puts) const {
+
+	PROBE(PROBE_MATRIX_PRICER);
+
+	if (first < 0 || first > m_count) throw OutOfBoundsException(first);
+	if (count < 0 || count > m_count - first) throw OutOfBoundsException(first + count);
+
+	double base[7];
+
+	for (int j = 0; j < m_base.Size(); ++j) {
+		base[j] = m_base[j];
+	}
+
+	if (m_base.OptionStyle() == "EO") {
+
+		double values[SWEEP_BLOCK];
+
+		for (int offset = 0; offset < count; offset += SWEEP_BLOCK) {
+
+			int m = min(SWEEP_BLOCK, count - offset);
+
+			for (int k = 0; k < m; ++k) {
+				values[k] = m_start + (first + offset + k) * m_step;
+			}
+
+			SweepBatch(m, m_index, base, values, calls + offset, puts + offset);
+		}
+	}
+
+	else if (m_base.OptionStyle() == "PAO") {
+
+		// 0: S, 1: K, 2: r, 3: b, 4: sig
+		for (int i = 0; i < count; ++i) {
+
+			base[m_index] = m_start + (first + i) * m_step;
+
+			calls[i] = PerpetualCall<double>(base[0], base[1], base[2], base[3], base[4]);
+			puts[i] = PerpetualPut<double>(base[0], base[1], base[2], base[3], base[4]);
+		}
+	}
+
+	else {
+		for (int i = 0; i < count; ++i) {
+			calls[i] = 0;
+			puts[i] = 0;
+		}
+	}
+}
+
+
+
+// Calculates the deltas and gammas of every row and returns them in a tuple
+boost::tuple<vector<double>, vector<double>, vector<double>> Sweep::MatrixPricer(Greeks g) const {
+
+	vector<double> delta_calls(m_count);
+	vector<double> delta_puts(m_count);
+	vector<double> gamma(m_count);
+
+	if (m_count > 0) {
+		this->MatrixPricer(g, &delta_calls[0], &delta_puts[0], &gamma[0]);
+	}
+
+	boost::tuple<vector<double>, vector<double>, vector<double>> tup(delta_calls, delta_puts, gamma);
+
+	return tup;
+}
+
+
+// Calculates the deltas and gammas of every row into caller-provided buffers
+// The rows of a block are laid out as arrays for the greeks batch kernel, and only the swept array changes between blocks
+// A Sweep of another style than EuropeanOptions has no greeks, and its buffers are set to 0
+void Sweep::MatrixPricer(const Greeks&, double* delta_calls, double* delta_puts, double* gamma) const {
+
+	PROBE(PROBE_MATRIX_PRICER);
+
+	if (m_base.OptionStyle() != "EO") {
+
+		for (int i = 0; i < m_count; ++i) {
+			delta_calls[i] = 0;
+			delta_puts[i] = 0;
+			gamma[i] = 0;
+		}
+
+		return;
+	}
+
+	// 0: S, 1: K, 2: T, 3: r, 4: b, 5: sig
+	// The block lives on the stack so that pricing a Sweep does not allocate
+	double params[6][SWEEP_BLOCK];
+
+	for (int j = 0; j < 6; ++j) {
+		std::fill(params[j], params[j] + SWEEP_BLOCK, m_base[j]);
+	}
+
+	for (int offset = 0; offset < m_count; offset += SWEEP_BLOCK) {
+
+		int m = min(SWEEP_BLOCK, m_count - offset);
+
+		// The dividend rate does not enter the greeks, so a sweep of it keeps the first row
+		if (m_index < 6) {
+			for (int k = 0; k < m; ++k) {
+				params[m_index][k] = m_start + (offset + k) * m_step;
+			}
+		}
+
+		GreeksBatch(m, &params[0][0], &params[1][0], &params[2][0], &params[3][0], &params[4][0], &params[5][0], delta_calls + offset, delta_puts + offset, gamma + offset);
+	}
+}
+
+
+
+// Outputs the first n rows
+void Sweep::OutputMatrix(const double& n) const {
+
+	PROBE(PROBE_OUTPUT);
+
+	for (int i = 0; i < n; ++i) {
+
+		Vector row = this->GetRow(i);
+
+		for (int j = 0; j < row.Size(); ++j) {
+			std::cout << row[j] << " ";
+		}
+
+		std::cout << endl;
+	}
+
+	std::cout << endl;
+}
+
+
+// Outputs the first n rows and their prices
+void Sweep::ReadChange(const int& n) const {
+	this->OutputMatrix(n);
+	boost::tuple<vector<double>, vector<double>> tup = this->MatrixPricer();
+	ReadTuple(tup, n);
+}
+
+
+// Outputs the first n rows and their greeks
+void Sweep::ReadChange(Greeks g, const int& n) const {
+	this->OutputMatrix(n);
+	boost::tuple<vector<double>, vector<double>, vector<double>> tup = this->MatrixPricer(g);
+	ReadTuple(tup, n);
+}
@@ -0,0 +1,97 @@
+// Objective: Create the Sweep class, a compact form of a Matrix whose rows differ in one parameter
+
+// Ensure no errors if the header file is used twice
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+// Include the necessary header files
+#include "Matrix.hpp"
+#include "Greeks.hpp"
+#include <iostream>
+using namespace std;
+#include <vector>
+#include "boost/tuple/tuple.hpp"
+#include "boost/tuple/tuple_io.hpp"
+
+
+
+// Create the Sweep class
+// A Sweep stores the first row and the swept parameter as (index, start, step, count), and row i is the first row with start + i * step at index
+// It holds the same rows as the Matrix built from the same arguments, but in the size of one row instead of count rows,
+// so sweeps of 10^8 rows can be priced a range at a time into buffers of the caller
+// The swept values are computed as start + i * step rather than added up row by row, so the last digits can differ from the rows of a Matrix
+class Sweep {
+private:
+
+	// The first row, which also holds the option style
+	Vector m_base;
+
+	// The swept parameter
+	int m_index;
+	double m_start;
+	double m_step;
+	int m_count;
+
+public:
+
+	// Default constructor
+	// An empty Sweep
+	Sweep();
+
+	// Parameter constructor for a EuropeanOption, with the same arguments as the Matrix constructor
+	// Throws an OutOfBoundsException if the index is not between 0 and 6
+	Sweep(EuropeanOption EO, double S, int index, double b, double n);
+
+	// Parameter constructor for a PerpetualAmericanOption, with the same arguments as the Matrix constructor
+	// Throws an OutOfBoundsException if the index is not between 0 and 5
+	Sweep(PerpetualAmericanOption PAO, double S, int index, double b, double n);
+
+	// Destructor
+	virtual ~Sweep();
+
+	// Copy constructor
+	Sweep(const Sweep& source);
+
+	// Assignment operator
+	Sweep& operator = (const Sweep& source);
+
+	// Returns row i, generated from the first row
+	// Throws an OutOfBoundsException if the row is out of bounds
+	Vector GetRow(const int& index) const;
+
+	// Returns the swept parameter of row i
+	double Value(const int& index) const;
+
+	// Returns the number of rows
+	int GetSize() const;
+
+	// Prices the call/put options of every row and returns a tuple with a vector of calls and a vector of puts
+	boost::tuple<vector<double>, vector<double>> MatrixPricer() const;
+
+	// Prices the call/put options of every row into caller-provided buffers with one entry per row
+	void MatrixPricer(double* calls, double* puts) const;
+
+	// Prices the call/put options of rows [first, first + count) into caller-provided buffers with count entries
+	// Throws an OutOfBoundsException if the range is out of bounds
+	void MatrixPricer(const int& first, const int& count, double* calls, double* puts) const;
+
+	// Calculates the call/put options' deltas and gammas of every row of a Sweep of EuropeanOptions given a Greek
+	boost::tuple<vector<double>, vector<double>, vector<double>> MatrixPricer(Greeks g) const;
+
+	// Calculates the call/put options' deltas and gammas of every row into caller-provided buffers with one entry per row
+	void MatrixPricer(const Greeks& g, double* delta_calls, double* delta_puts, double* gamma) const;
+
+	// Outputs the first n rows
+	void OutputMatrix(const double& n) const;
+
+	// Outputs the first n rows and their prices
+	void ReadChange(const int& n) const;
+
+	// Outputs the first n rows and their greeks
+	void ReadChange(Greeks g, const int& n) const;
+
+};
+
+
+
+#endif
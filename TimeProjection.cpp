@@ -0,0 +1,229 @@
+// Objective: Implement the TimeProjection class
+
+// Include the necessary header files
+#include "TimeProjection.hpp"
+#include "EuropeanOption.hpp"
+#include "Exception.hpp"
+#include "Kernels.hpp"
+#include <iostream>
+using namespace std;
+#include <cmath>
+#include <vector>
+#include <thread>
+#include "Scheduler.hpp"
+#include <algorithm>
+
+
+
+// Default constructor
+TimeProjection::TimeProjection() : m_options(), m_spots(), m_quantities(), m_dates(), m_threads(max(1, int(std::thread::hardware_concurrency()))), m_values(), m_deltas(), m_gammas() {}
+
+
+// Parameter constructor
+TimeProjection::TimeProjection(int threads) : m_options(), m_spots(), m_quantities(), m_dates(), m_threads(max(1, threads)), m_values(), m_deltas(), m_gammas() {}
+
+
+// Destructor
+TimeProjection::~TimeProjection() {}
+
+
+// Copy constructor
+TimeProjection::TimeProjection(const TimeProjection& source) : m_options(source.m_options), m_spots(source.m_spots), m_quantities(source.m_quantities), m_dates(source.m_dates), m_threads(source.m_threads),
+	m_values(source.m_values), m_deltas(source.m_deltas), m_gammas(source.m_gammas) {}
+
+
+// Assignment operator
+TimeProjection& TimeProjection::operator = (const TimeProjection& source) {
+
+	if (this == &source) {
+		return *this;
+	}
+
+	m_options = source.m_options;
+	m_spots = source.m_spots;
+	m_quantities = source.m_quantities;
+	m_dates = source.m_dates;
+	m_threads = source.m_threads;
+	m_values = source.m_values;
+	m_deltas = source.m_deltas;
+	m_gammas = source.m_gammas;
+
+	return *this;
+}
+
+
+
+// Adds a position to the book
+void TimeProjection::AddPosition(const EuropeanOption& option, const double& S, const double& quantity) {
+	m_options.push_back(option);
+	m_spots.push_back(S);
+	m_quantities.push_back(quantity);
+}
+
+
+// Returns the number of positions
+int TimeProjection::Positions() const {
+	return m_options.size();
+}
+
+
+// Returns the number of dates of the last projection
+int TimeProjection::Dates() const {
+	return m_dates.size();
+}
+
+
+
+// Projects the positions in [first, last)
+// The spot price does not move, so log(S / K) and the call/put check are done once per position and only the time-dependent terms are computed per date
+void TimeProjection::ProjectPositions(const int& first, const int& last) {
+
+	int nd = m_dates.size();
+
+	for (int p = first; p < last; ++p) {
+
+		const EuropeanOption& option = m_options[p];
+
+		double S = m_spots[p];
+		double K = option.StrikePrice();
+		double r = option.RiskFreeRate();
+		double b = option.CostOfCarry();
+		double sig = option.Volatility();
+		double logSK = log(S / K);
+		double half = (sig * sig) * 0.5;
+		bool call = option.OptionType() == "Call";
+
+		for (int d = 0; d < nd; ++d) {
+
+			int cell = p * nd + d;
+			double T = option.Expiry() - m_dates[d];
+
+			// The option has expired by this date
+			if (T <= 0) {
+
+				m_values[cell] = call ? max(S - K, 0.0) : max(K - S, 0.0);
+				m_deltas[cell] = call ? (S > K ? 1.0 : 0.0) : (S < K ? -1.0 : 0.0);
+				m_gammas[cell] = 0;
+
+				continue;
+			}
+
+			double tmp = sig * sqrt(T);
+			double df = exp(-r * T);
+			double cf = exp((b - r) * T);
+
+			// d1 and d2 of the generalized model, shared by the prices and the greeks as in the EuropeanOption class
+			double d1 = (logSK + (b + half) * T) / tmp;
+			double d2 = d1 - tmp;
+
+			if (call) {
+				m_values[cell] = S * NormalCDF(d1) * cf - K * df * NormalCDF(d2);
+				m_deltas[cell] = cf * NormalCDF(d1);
+			}
+
+			else {
+				m_values[cell] = K * NormalCDF(-d2) * df - S * NormalCDF(-d1) * cf;
+				m_deltas[cell] = cf * (NormalCDF(d1) - 1.0);
+			}
+
+			m_gammas[cell] = NormalPDF(d1) * cf / (S * tmp);
+		}
+	}
+}
+
+
+
+// Values every position at every date
+// The positions are handed to the Scheduler as one loop of at most m_threads tasks, or projected on the calling thread when the projection has one thread
+void TimeProjection::Project(const std::vector<double>& dates) {
+
+	m_dates = dates;
+
+	int np = m_options.size();
+	int cells = np * m_dates.size();
+
+	m_values.assign(cells, 0.0);
+	m_deltas.assign(cells, 0.0);
+	m_gammas.assign(cells, 0.0);
+
+	if (m_threads == 1) {
+		this->ProjectPositions(0, np);
+		return;
+	}
+
+	Scheduler::Global().ParallelFor(0, np, 0, [this](int first, int last) { this->ProjectPositions(first, last); }, m_threads);
+}
+
+
+
+// Accessors for the blocks of the last projection
+
+const std::vector<double>& TimeProjection::Values() const {
+	return m_values;
+}
+
+const std::vector<double>& TimeProjection::Deltas() const {
+	return m_deltas;
+}
+
+const std::vector<double>& TimeProjection::Gammas() const {
+	return m_gammas;
+}
+
+
+
+// Value of the book at a date of the last projection
+double TimeProjection::BookValue(const int& date) const {
+
+	int nd = m_dates.size();
+
+	if (date < 0 || date >= nd) throw OutOfBoundsException(date);
+
+	int np = m_values.size() / nd;
+
+	double total = 0;
+
+	for (int p = 0; p < np; ++p) {
+		total += m_quantities[p] * m_values[p * nd + date];
+	}
+
+	return total;
+}
+
+
+// Delta of the book at a date of the last projection
+double TimeProjection::BookDelta(const int& date) const {
+
+	int nd = m_dates.size();
+
+	if (date < 0 || date >= nd) throw OutOfBoundsException(date);
+
+	int np = m_deltas.size() / nd;
+
+	double total = 0;
+
+	for (int p = 0; p < np; ++p) {
+		total += m_quantities[p] * m_deltas[p * nd + date];
+	}
+
+	return total;
+}
+
+
+// Gamma of the book at a date of the last projection
+double TimeProjection::BookGamma(const int& date) const {
+
+	int nd = m_dates.size();
+
+	if (date < 0 || date >= nd) throw OutOfBoundsException(date);
+
+	int np = m_gammas.size() / nd;
+
+	double total = 0;
+
+	for (int p = 0; p < np; ++p) {
+		total += m_quantities[p] * m_gammas[p * nd + date];
+	}
+
+	return total;
+}
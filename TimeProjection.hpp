@@ -0,0 +1,87 @@
+// Objective: Create the TimeProjection class that projects the value and greeks of a book of European Options forward in time
+
+// Ensure no errors if the header file is used twice
+#ifndef TIMEPROJECTION_HPP
+#define TIMEPROJECTION_HPP
+
+// Include header files
+#include "EuropeanOption.hpp"
+#include <iostream>
+#include <vector>
+using namespace std;
+
+
+
+// Create the TimeProjection class
+// A valuation date is the time from today in years, so each option is valued with its expiry reduced by the date
+// Options that have expired by a date are worth their intrinsic value, with a delta of 1, -1, or 0 and a gamma of 0
+// The results are stored position by position, with Positions() x Dates() entries per block
+class TimeProjection {
+private:
+
+	// The book: the options, their spot prices, and their quantities
+	std::vector<EuropeanOption> m_options;
+	std::vector<double> m_spots;
+	std::vector<double> m_quantities;
+
+	// The valuation dates of the last projection
+	std::vector<double> m_dates;
+
+	// The number of threads used to project
+	// The loop over the positions is split into at most this many tasks of the Scheduler, so no more threads than this, and than the Scheduler has workers, run it
+	int m_threads;
+
+	// The value, delta, and gamma of one unit of each position at each date
+	std::vector<double> m_values;
+	std::vector<double> m_deltas;
+	std::vector<double> m_gammas;
+
+	// Projects the positions in [first, last)
+	void ProjectPositions(const int& first, const int& last);
+
+public:
+
+	// Default constructor
+	// Uses one thread per hardware thread
+	TimeProjection();
+
+	// Parameter constructor with the number of threads, where a number below 1 is taken as 1
+	// With 1 thread the positions are projected on the calling thread
+	TimeProjection(int threads);
+
+	// Destructor
+	virtual ~TimeProjection();
+
+	// Copy constructor
+	TimeProjection(const TimeProjection& source);
+
+	// Assignment operator
+	TimeProjection& operator = (const TimeProjection& source);
+
+	// Adds a position to the book
+	void AddPosition(const EuropeanOption& option, const double& S, const double& quantity);
+
+	// Returns the number of positions and the number of dates of the last projection
+	int Positions() const;
+	int Dates() const;
+
+	// Values every position at every date
+	void Project(const std::vector<double>& dates);
+
+	// Accessors for the blocks of the last projection
+	const std::vector<double>& Values() const;
+	const std::vector<double>& Deltas() const;
+	const std::vector<double>& Gammas() const;
+
+	// Value, delta, and gamma of the book, weighted by the quantities, at a date of the last projection
+	// Throws an OutOfBoundsException if the date is not an index of the dates of the last projection
+	// Positions added after the last projection are not included
+	double BookValue(const int& date) const;
+	double BookDelta(const int& date) const;
+	double BookGamma(const int& date) const;
+
+};
+
+
+
+#endif